@@ -0,0 +1,261 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <variant>
+#include <vector>
+#include "../../cpputils/microbench.cpp"
+
+// CRTP handler framework: static dispatch for event handlers, batched.
+//
+// crtp.cpp shows the CRTP idiom and visit_vs_virtual.cpp measures why a
+// virtual IOperation-style hierarchy is slow — every event pays an indirect
+// call the optimizer can't see through. This file puts the two together as
+// a reusable shape: handlers derive from Handler<Derived, Event>, and the
+// event loop is a template over the whole handler set, so every dispatch
+// site is resolved at compile time. Homogeneous runs of events execute
+// through executeAll(span) — one monomorphic loop per concrete type that
+// the compiler inlines (and often vectorizes), which is where the batch
+// win over per-event dispatch comes from.
+
+template <typename Derived, typename Event>
+class Handler {
+public:
+    using event_type = Event;
+
+    // Single-event path: delegates to the derived handler with no vtable.
+    void execute(const Event& event) { derived().onEvent(event); }
+
+    // Batch path: a monomorphic loop over events of one concrete type.
+    // Since onEvent is statically bound, the whole loop body inlines into
+    // this frame — no indirect call per event for the predictor to miss.
+    void executeAll(std::span<const Event> events) {
+        for (const Event& event : events) {
+            derived().onEvent(event);
+        }
+    }
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+};
+
+// Event loop templated over the handler set. Events are queued as a variant
+// over the handlers' event types; run() walks the queue, slices it into
+// maximal runs of one alternative, and hands each run to that handler's
+// executeAll. Replay workloads arrive heavily run-structured (bursts of
+// quotes, then a burst of trades), so most events execute in long
+// monomorphic batches; a fully interleaved queue degrades gracefully to
+// batch-of-one.
+template <typename... Handlers>
+class EventLoop {
+public:
+    using EventVariant = std::variant<typename Handlers::event_type...>;
+
+    void post(EventVariant event) { queue.push_back(std::move(event)); }
+
+    void run() {
+        runOver(queue);
+        queue.clear();
+    }
+
+    // Executes a batch of events held by the caller (e.g. a replay buffer)
+    // without copying them into the internal queue first.
+    void runOver(std::span<const EventVariant> events) {
+        size_t begin = 0;
+        while (begin < events.size()) {
+            const size_t type = events[begin].index();
+            size_t end = begin + 1;
+            while (end < events.size() && events[end].index() == type) {
+                ++end;
+            }
+            dispatchRun(events, type, begin, end,
+                        std::index_sequence_for<Handlers...>{});
+            begin = end;
+        }
+    }
+
+    // Access to handler state (positions, checksums, ...) after a run.
+    template <typename HandlerT>
+    HandlerT& handler() { return std::get<HandlerT>(handlers); }
+
+private:
+    // Same fold-over-indices trick as fastVisit in visit_vs_virtual.cpp:
+    // the optimizer collapses it into a dense switch on the run's type.
+    template <size_t... Is>
+    void dispatchRun(std::span<const EventVariant> events, size_t type,
+                     size_t begin, size_t end, std::index_sequence<Is...>) {
+        ((type == Is ? runAs<Is>(events, begin, end) : void()), ...);
+    }
+
+    // Gathers the run's payloads into contiguous storage of the concrete
+    // type (a linear copy of small PODs), then executes the batch. The
+    // gather is the same pass executeBatchSorted pays, charged per run.
+    template <size_t I>
+    void runAs(std::span<const EventVariant> events, size_t begin, size_t end) {
+        using Event = std::variant_alternative_t<I, EventVariant>;
+        scratchFor<Event>().clear();
+        for (size_t i = begin; i < end; ++i) {
+            scratchFor<Event>().push_back(*std::get_if<I>(&events[i]));
+        }
+        std::get<I>(handlers).executeAll(
+            std::span<const Event>(scratchFor<Event>()));
+    }
+
+    template <typename Event>
+    static std::vector<Event>& scratchFor() {
+        static thread_local std::vector<Event> scratch;
+        return scratch;
+    }
+
+    std::tuple<Handlers...> handlers;
+    std::vector<EventVariant> queue;
+};
+
+// The Move/Rotate/Scale workload from visit_vs_virtual.cpp, ported to the
+// framework. Handlers accumulate into a checksum so the work survives -O2.
+
+struct Move { double x, y; };
+struct Rotate { double angle; };
+struct Scale { double factor; };
+
+class MoveHandler : public Handler<MoveHandler, Move> {
+public:
+    void onEvent(const Move& e) { checksum += e.x + e.y; }
+    double checksum = 0;
+};
+
+class RotateHandler : public Handler<RotateHandler, Rotate> {
+public:
+    void onEvent(const Rotate& e) {
+        checksum += e.angle * 3.141592653589793 / 180.0;
+    }
+    double checksum = 0;
+};
+
+class ScaleHandler : public Handler<ScaleHandler, Scale> {
+public:
+    void onEvent(const Scale& e) { checksum += e.factor * e.factor; }
+    double checksum = 0;
+};
+
+using ReplayLoop = EventLoop<MoveHandler, RotateHandler, ScaleHandler>;
+
+// Virtual baseline: the IOperation shape our handlers still have today.
+struct IEventHandler {
+    virtual void execute() = 0;
+    virtual ~IEventHandler() = default;
+};
+
+struct VirtualMove : IEventHandler {
+    double x, y;
+    double* checksum;
+    VirtualMove(double x, double y, double* c) : x(x), y(y), checksum(c) {}
+    void execute() override { *checksum += x + y; }
+};
+
+struct VirtualRotate : IEventHandler {
+    double angle;
+    double* checksum;
+    VirtualRotate(double a, double* c) : angle(a), checksum(c) {}
+    void execute() override { *checksum += angle * 3.141592653589793 / 180.0; }
+};
+
+struct VirtualScale : IEventHandler {
+    double factor;
+    double* checksum;
+    VirtualScale(double f, double* c) : factor(f), checksum(c) {}
+    void execute() override { *checksum += factor * factor; }
+};
+
+// Replay-shaped workload: runs of 64 same-type events, cycling through the
+// three types — the structure the run-slicer exploits.
+constexpr int kNumEvents = 4096;
+constexpr int kRunLength = 64;
+
+static double gVirtualChecksum = 0;
+
+static const std::vector<std::unique_ptr<IEventHandler>>& virtualEvents() {
+    static const std::vector<std::unique_ptr<IEventHandler>> events = [] {
+        std::vector<std::unique_ptr<IEventHandler>> built;
+        for (int i = 0; built.size() < kNumEvents; ++i) {
+            for (int j = 0; j < kRunLength; ++j) {
+                switch (i % 3) {
+                    case 0: built.push_back(std::make_unique<VirtualMove>(10.0, 20.0, &gVirtualChecksum)); break;
+                    case 1: built.push_back(std::make_unique<VirtualRotate>(90.0, &gVirtualChecksum)); break;
+                    case 2: built.push_back(std::make_unique<VirtualScale>(1.5, &gVirtualChecksum)); break;
+                }
+            }
+        }
+        return built;
+    }();
+    return events;
+}
+
+static const std::vector<ReplayLoop::EventVariant>& crtpEvents() {
+    static const std::vector<ReplayLoop::EventVariant> events = [] {
+        std::vector<ReplayLoop::EventVariant> built;
+        for (int i = 0; built.size() < kNumEvents; ++i) {
+            for (int j = 0; j < kRunLength; ++j) {
+                switch (i % 3) {
+                    case 0: built.emplace_back(Move{10.0, 20.0}); break;
+                    case 1: built.emplace_back(Rotate{90.0}); break;
+                    case 2: built.emplace_back(Scale{1.5}); break;
+                }
+            }
+        }
+        return built;
+    }();
+    return events;
+}
+
+void bmVirtualHandlers(size_t iterations) {
+    const auto& events = virtualEvents();
+    for (size_t done = 0; done < iterations; done += events.size()) {
+        for (const auto& event : events) {
+            event->execute();
+        }
+    }
+    doNotOptimize(gVirtualChecksum);
+}
+
+// Executes the prebuilt replay buffer in place: run slicing and the
+// per-run gather copy are charged, queue construction (which both shapes
+// would pay alike) is not.
+void bmCrtpBatchHandlers(size_t iterations) {
+    static ReplayLoop loop; // Handler state persists like real handlers'
+    const auto& events = crtpEvents();
+    for (size_t done = 0; done < iterations; done += events.size()) {
+        loop.runOver(events);
+    }
+    doNotOptimize(loop.handler<MoveHandler>().checksum);
+}
+
+MICROBENCHMARK(bmVirtualHandlers);
+MICROBENCHMARK(bmCrtpBatchHandlers);
+
+int main() {
+    // Correctness first: both paths over one pass must agree.
+    ReplayLoop loop;
+    for (const auto& event : crtpEvents()) {
+        loop.post(event);
+    }
+    loop.run();
+    const double crtpTotal = loop.handler<MoveHandler>().checksum +
+                             loop.handler<RotateHandler>().checksum +
+                             loop.handler<ScaleHandler>().checksum;
+    gVirtualChecksum = 0;
+    for (const auto& event : virtualEvents()) {
+        event->execute();
+    }
+    // Per-handler partial sums add in a different order than the straight
+    // event walk, so compare with a tolerance rather than bit-exactly.
+    const bool match = std::abs(gVirtualChecksum - crtpTotal) < 1e-6;
+    std::cout << "checksums: virtual=" << gVirtualChecksum
+              << " crtp=" << crtpTotal << (match ? " (match)\n" : " (MISMATCH)\n");
+
+    const std::vector<BenchResult> results = BenchmarkRegistry::instance().runAll(std::cout);
+    std::cout << "\n";
+    BenchmarkRegistry::writeJson(results, std::cout);
+    return 0;
+}
@@ -1,10 +1,23 @@
 #include <iostream>
 #include <array>
 #include <chrono>
+#include <algorithm>
+#include <immintrin.h>
 
 // Matrix size constants for simplicity
 constexpr size_t N = 3; // 3x3 matrices
 
+// Widest vector unit available on this CPU, probed once via cpuid.
+enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+inline SimdLevel simd_level() {
+    static const SimdLevel level = [] {
+        if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+        return SimdLevel::Scalar;
+    }();
+    return level;
+}
 
 // Base expression class
 template <typename E>
@@ -15,14 +28,32 @@ public:
     }
 
     size_t size() const {
-        return N;
+        return E::extent;
     }
 };
 
+// Whether an expression can evaluate a whole vector register at once.
+// Elementwise nodes over double matrices can; anything else falls back to
+// the scalar assignment loop.
+template <typename E>
+struct HasPacket : std::false_type {};
+
+// Whether an expression tree contains a multiplication anywhere. Such trees
+// are evaluated through the accumulation path at assignment time instead of
+// elementwise (a product's operator() would redo its dot product for every
+// (i, j) the enclosing expression asks for).
+template <typename E>
+struct ContainsMul : std::false_type {};
+
+template <typename E>
+struct IsMatrix : std::false_type {};
+
 // Matrix class representing a concrete matrix
 template <typename T, size_t N>
 class Matrix : public Expression<Matrix<T, N>> {
 public:
+    static constexpr size_t extent = N;
+
     std::array<std::array<T, N>, N> data;
 
     Matrix() {
@@ -41,9 +72,41 @@ public:
     T& operator()(size_t i, size_t j) { return data[i][j]; }
     T operator()(size_t i, size_t j) const { return data[i][j]; }
 
-    // Assignment from any expression
+    // Four/eight consecutive elements of row i starting at column j, as a
+    // vector register. Only instantiated for T = double via HasPacket.
+    __attribute__((target("avx2")))
+    __m256d packet4(size_t i, size_t j) const {
+        return _mm256_loadu_pd(&data[i][j]);
+    }
+
+    __attribute__((target("avx512f")))
+    __m512d packet8(size_t i, size_t j) const {
+        return _mm512_loadu_pd(&data[i][j]);
+    }
+
+    // Assignment from any expression: the fused loop is dispatched once per
+    // assignment on the cpuid probe. Vector kernels evaluate the expression
+    // a full register at a time; the scalar loop is the universal fallback.
     template <typename E>
     Matrix& operator=(const Expression<E>& expr) {
+        const E& e = static_cast<const E&>(expr);
+        if constexpr (ContainsMul<E>::value) {
+            // Zero the destination, then let every term accumulate into it:
+            // D = A*B + C*E runs as tiled multiply-accumulates plus
+            // elementwise adds, with no intermediate matrices.
+            for (auto& row : data) {
+                row.fill(T());
+            }
+            e.accumulate_into(*this);
+            return *this;
+        }
+        if constexpr (HasPacket<E>::value && std::is_same_v<T, double>) {
+            switch (simd_level()) {
+                case SimdLevel::Avx512: assign_avx512(e); return *this;
+                case SimdLevel::Avx2: assign_avx2(e); return *this;
+                case SimdLevel::Scalar: break;
+            }
+        }
         for (size_t i = 0; i < N; ++i) {
             for (size_t j = 0; j < N; ++j) {
                 data[i][j] = expr(i, j);
@@ -51,12 +114,89 @@ public:
         }
         return *this;
     }
+
+    // Accumulation-path leaf: add this matrix into `dest` elementwise.
+    template <typename T2>
+    void accumulate_into(Matrix<T2, N>& dest) const {
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t j = 0; j < N; ++j) {
+                dest(i, j) += data[i][j];
+            }
+        }
+    }
+
+private:
+    template <typename E>
+    __attribute__((target("avx2")))
+    void assign_avx2(const E& expr) {
+        for (size_t i = 0; i < N; ++i) {
+            size_t j = 0;
+            for (; j + 4 <= N; j += 4) {
+                _mm256_storeu_pd(&data[i][j], expr.packet4(i, j));
+            }
+            for (; j < N; ++j) {
+                data[i][j] = expr(i, j);
+            }
+        }
+    }
+
+    template <typename E>
+    __attribute__((target("avx512f")))
+    void assign_avx512(const E& expr) {
+        for (size_t i = 0; i < N; ++i) {
+            size_t j = 0;
+            for (; j + 8 <= N; j += 8) {
+                _mm512_storeu_pd(&data[i][j], expr.packet8(i, j));
+            }
+            for (; j + 4 <= N; j += 4) {
+                _mm256_storeu_pd(&data[i][j], expr.packet4(i, j));
+            }
+            for (; j < N; ++j) {
+                data[i][j] = expr(i, j);
+            }
+        }
+    }
 };
 
+template <size_t N>
+struct HasPacket<Matrix<double, N>> : std::true_type {};
+
+template <typename T, size_t N>
+struct IsMatrix<Matrix<T, N>> : std::true_type {};
+
+// Tiled multiply-accumulate: dest += A * B. The loop nest is blocked so a
+// kTile x kTile panel of B stays in L1 across the whole ii block, and the
+// inner update walks row j with unit stride against a scalar a_ik — the
+// shape the vectorizer turns into fused multiply-adds. This replaces the
+// cache-oblivious triple loop for every product in an expression.
+template <typename T, size_t N>
+void multiply_accumulate(Matrix<T, N>& dest, const Matrix<T, N>& A, const Matrix<T, N>& B) {
+    constexpr size_t kTile = 32; // 32x32 doubles = 8KB per panel
+    for (size_t ii = 0; ii < N; ii += kTile) {
+        const size_t iEnd = std::min(ii + kTile, N);
+        for (size_t kk = 0; kk < N; kk += kTile) {
+            const size_t kEnd = std::min(kk + kTile, N);
+            for (size_t jj = 0; jj < N; jj += kTile) {
+                const size_t jEnd = std::min(jj + kTile, N);
+                for (size_t i = ii; i < iEnd; ++i) {
+                    for (size_t k = kk; k < kEnd; ++k) {
+                        const T a = A(i, k);
+                        for (size_t j = jj; j < jEnd; ++j) {
+                            dest(i, j) += a * B(k, j);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 // Expression class for matrix addition
 template <typename LHS, typename RHS>
 class MatrixAdd : public Expression<MatrixAdd<LHS, RHS>> {
 public:
+    static constexpr size_t extent = LHS::extent;
+
     const LHS& lhs;
     const RHS& rhs;
 
@@ -65,8 +205,34 @@ public:
     auto operator()(size_t i, size_t j) const {
         return lhs(i, j) + rhs(i, j);
     }
+
+    __attribute__((target("avx2")))
+    __m256d packet4(size_t i, size_t j) const {
+        return _mm256_add_pd(lhs.packet4(i, j), rhs.packet4(i, j));
+    }
+
+    __attribute__((target("avx512f")))
+    __m512d packet8(size_t i, size_t j) const {
+        return _mm512_add_pd(lhs.packet8(i, j), rhs.packet8(i, j));
+    }
+
+    // A sum accumulates term by term; the destination is the only storage.
+    template <typename T>
+    void accumulate_into(Matrix<T, extent>& dest) const {
+        lhs.accumulate_into(dest);
+        rhs.accumulate_into(dest);
+    }
 };
 
+// An addition vectorizes iff both operands do.
+template <typename LHS, typename RHS>
+struct HasPacket<MatrixAdd<LHS, RHS>>
+    : std::conjunction<HasPacket<LHS>, HasPacket<RHS>> {};
+
+template <typename LHS, typename RHS>
+struct ContainsMul<MatrixAdd<LHS, RHS>>
+    : std::disjunction<ContainsMul<LHS>, ContainsMul<RHS>> {};
+
 // Expression class for matrix multiplication
 template <typename LHS, typename RHS>
 class MatrixMul : public Expression<MatrixMul<LHS, RHS>> {
@@ -74,17 +240,45 @@ public:
     const LHS& lhs;
     const RHS& rhs;
 
+    static constexpr size_t extent = LHS::extent;
+
     MatrixMul(const LHS& lhs, const RHS& rhs) : lhs(lhs), rhs(rhs) {}
 
     auto operator()(size_t i, size_t j) const {
         decltype(lhs(i, j) * rhs(i, j)) result = 0;
-        for (size_t k = 0; k < N; ++k) {
+        for (size_t k = 0; k < extent; ++k) {
             result += lhs(i, k) * rhs(k, j);
         }
         return result;
     }
+
+    // dest += lhs * rhs via the tiled kernel. Concrete matrix operands feed
+    // the kernel directly; an expression operand (e.g. (A + B) * D) is
+    // reduced to a matrix first — that evaluation is itself fused, so only
+    // genuinely nested products ever materialize.
+    template <typename T>
+    void accumulate_into(Matrix<T, extent>& dest) const {
+        const auto& a = materialize<T>(lhs);
+        const auto& b = materialize<T>(rhs);
+        multiply_accumulate(dest, a, b);
+    }
+
+private:
+    template <typename T, typename E>
+    static decltype(auto) materialize(const E& operand) {
+        if constexpr (IsMatrix<E>::value) {
+            return (operand);
+        } else {
+            Matrix<T, extent> tmp;
+            tmp = operand;
+            return tmp;
+        }
+    }
 };
 
+template <typename LHS, typename RHS>
+struct ContainsMul<MatrixMul<LHS, RHS>> : std::true_type {};
+
 // Operator overloads to create expressions
 template <typename LHS, typename RHS>
 auto operator+(const Expression<LHS>& lhs, const Expression<RHS>& rhs) {
@@ -96,6 +290,202 @@ auto operator*(const Expression<LHS>& lhs, const Expression<RHS>& rhs) {
     return MatrixMul<LHS, RHS>(static_cast<const LHS&>(lhs), static_cast<const RHS&>(rhs));
 }
 
+#include <type_traits>
+#include <vector>
+
+// ---- Compile-time common-subexpression elimination ----
+//
+// A formula like (A + B) * C + (A + B) * E names (A + B) twice, and the
+// expression tree dutifully evaluates it twice — once inside each product.
+// The compiler can't fold them: each evaluation disappears into the opaque
+// tiled kernel. But the tree's *type* spells out its whole structure, so the
+// duplication is visible at compile time: the subtree type MatrixAdd<.,.>
+// occurs twice in the pre-order type list of the root expression.
+//
+// cse_assign() finds the first (i.e. topmost) compound subtree type that
+// repeats, confirms at runtime that the occurrences really are the same
+// subexpression (same node types can still hang off different matrices, so
+// leaf addresses are compared), evaluates it once into a named temporary,
+// and then evaluates the full tree with every occurrence replaced by that
+// temporary. Trees with no repetition compile to exactly the normal path.
+
+template <typename E> struct IsAdd : std::false_type {};
+template <typename LHS, typename RHS>
+struct IsAdd<MatrixAdd<LHS, RHS>> : std::true_type {};
+
+template <typename E> struct IsMul : std::false_type {};
+template <typename LHS, typename RHS>
+struct IsMul<MatrixMul<LHS, RHS>> : std::true_type {};
+
+template <typename... Ts> struct TypeList {};
+
+template <typename A, typename B> struct Concat;
+template <typename... As, typename... Bs>
+struct Concat<TypeList<As...>, TypeList<Bs...>> {
+    using type = TypeList<As..., Bs...>;
+};
+
+// Pre-order list of every subtree type: the root comes before its pieces,
+// so the first repeated entry is an outermost one (eliminating it subsumes
+// any repetition inside it).
+template <typename E> struct SubtreeList { using type = TypeList<E>; };
+template <typename LHS, typename RHS>
+struct SubtreeList<MatrixAdd<LHS, RHS>> {
+    using type = typename Concat<
+        TypeList<MatrixAdd<LHS, RHS>>,
+        typename Concat<typename SubtreeList<LHS>::type,
+                        typename SubtreeList<RHS>::type>::type>::type;
+};
+template <typename LHS, typename RHS>
+struct SubtreeList<MatrixMul<LHS, RHS>> {
+    using type = typename Concat<
+        TypeList<MatrixMul<LHS, RHS>>,
+        typename Concat<typename SubtreeList<LHS>::type,
+                        typename SubtreeList<RHS>::type>::type>::type;
+};
+
+template <typename T, typename List> struct CountIn;
+template <typename T>
+struct CountIn<T, TypeList<>> : std::integral_constant<size_t, 0> {};
+template <typename T, typename Head, typename... Rest>
+struct CountIn<T, TypeList<Head, Rest...>>
+    : std::integral_constant<size_t, (std::is_same_v<T, Head> ? 1 : 0) +
+                                     CountIn<T, TypeList<Rest...>>::value> {};
+
+// First compound type in `List` occurring at least twice in `FullList`;
+// void when the tree has no repetition. Bare Matrix leaves are excluded —
+// re-reading a matrix costs nothing, so a temporary buys nothing.
+template <typename List, typename FullList>
+struct FirstRepeated { using type = void; };
+template <typename Head, typename... Rest, typename FullList>
+struct FirstRepeated<TypeList<Head, Rest...>, FullList> {
+    using type = std::conditional_t<
+        !IsMatrix<Head>::value && (CountIn<Head, FullList>::value >= 2),
+        Head,
+        typename FirstRepeated<TypeList<Rest...>, FullList>::type>;
+};
+
+template <typename E>
+using RepeatedSubtree =
+    typename FirstRepeated<typename SubtreeList<E>::type,
+                           typename SubtreeList<E>::type>::type;
+
+// Equal node types guarantee equal shape, not equal operands: A + B and
+// C + D share a type. Two same-typed subtrees denote the same computation
+// iff their leaves are the same matrix objects.
+template <typename E>
+bool structurallyEqual(const E& a, const E& b) {
+    if constexpr (IsMatrix<E>::value) {
+        return &a == &b;
+    } else {
+        return structurallyEqual(a.lhs, b.lhs) && structurallyEqual(a.rhs, b.rhs);
+    }
+}
+
+// All nodes of type S in the tree, pre-order. S cannot nest inside itself
+// (a type can't be its own strict subexpression), so recursion stops at hits.
+template <typename S, typename E>
+void collectOccurrences(const E& e, std::vector<const S*>& out) {
+    if constexpr (std::is_same_v<E, S>) {
+        out.push_back(&e);
+    } else if constexpr (IsAdd<E>::value || IsMul<E>::value) {
+        collectOccurrences<S>(e.lhs, out);
+        collectOccurrences<S>(e.rhs, out);
+    }
+}
+
+// Elementwise evaluation with every S-typed node read from `cached`.
+template <typename S, typename E, typename T, size_t N>
+auto cseAt(const E& e, const Matrix<T, N>& cached, size_t i, size_t j) {
+    if constexpr (std::is_same_v<E, S>) {
+        return cached(i, j);
+    } else if constexpr (IsAdd<E>::value) {
+        return cseAt<S>(e.lhs, cached, i, j) + cseAt<S>(e.rhs, cached, i, j);
+    } else {
+        return e(i, j);
+    }
+}
+
+template <typename S, typename T, size_t N, typename E>
+void cseAccumulateInto(const E& e, const Matrix<T, N>& cached, Matrix<T, N>& dest);
+
+// A product operand is either usable as-is (a matrix, or the cached
+// temporary) or gets evaluated — with substitution — into a fresh matrix.
+template <typename S, typename E, typename T, size_t N>
+decltype(auto) cseMaterialize(const E& operand, const Matrix<T, N>& cached) {
+    if constexpr (std::is_same_v<E, S>) {
+        return (cached);
+    } else if constexpr (IsMatrix<E>::value) {
+        return (operand);
+    } else {
+        Matrix<T, N> tmp;
+        if constexpr (ContainsMul<E>::value) {
+            cseAccumulateInto<S>(operand, cached, tmp);
+        } else {
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    tmp(i, j) = cseAt<S>(operand, cached, i, j);
+                }
+            }
+        }
+        return tmp;
+    }
+}
+
+// Accumulation-path mirror of accumulate_into with the same substitution:
+// products still run through the tiled kernel, with any S-typed operand
+// feeding it as the already-evaluated temporary.
+template <typename S, typename T, size_t N, typename E>
+void cseAccumulateInto(const E& e, const Matrix<T, N>& cached, Matrix<T, N>& dest) {
+    if constexpr (std::is_same_v<E, S>) {
+        cached.accumulate_into(dest);
+    } else if constexpr (IsAdd<E>::value) {
+        cseAccumulateInto<S>(e.lhs, cached, dest);
+        cseAccumulateInto<S>(e.rhs, cached, dest);
+    } else if constexpr (IsMul<E>::value) {
+        multiply_accumulate(dest, cseMaterialize<S>(e.lhs, cached),
+                            cseMaterialize<S>(e.rhs, cached));
+    } else {
+        e.accumulate_into(dest);
+    }
+}
+
+// Assignment with compile-time CSE. When the tree's type reveals a repeated
+// compound subtree and the occurrences check out at runtime, each distinct
+// subexpression is computed exactly once.
+template <typename T, size_t N, typename E>
+void cse_assign(Matrix<T, N>& dest, const Expression<E>& expr) {
+    const E& e = static_cast<const E&>(expr);
+    using Repeated = RepeatedSubtree<E>;
+    if constexpr (std::is_void_v<Repeated>) {
+        dest = expr; // Nothing repeats; normal fused evaluation
+    } else {
+        std::vector<const Repeated*> occurrences;
+        collectOccurrences<Repeated>(e, occurrences);
+        for (size_t k = 1; k < occurrences.size(); ++k) {
+            if (!structurallyEqual(*occurrences[0], *occurrences[k])) {
+                dest = expr; // Same shape, different operands; no sharing
+                return;
+            }
+        }
+        Matrix<T, N> shared;
+        shared = *occurrences[0]; // The one and only evaluation of the subtree
+
+        if constexpr (ContainsMul<E>::value) {
+            for (auto& row : dest.data) {
+                row.fill(T());
+            }
+            cseAccumulateInto<Repeated>(e, shared, dest);
+        } else {
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    dest(i, j) = cseAt<Repeated>(e, shared, i, j);
+                }
+            }
+        }
+    }
+}
+
 // Direct matrix operations (without expression templates)
 template <typename T, size_t N>
 void matrix_add(const Matrix<T, N>& A, const Matrix<T, N>& B, Matrix<T, N>& C) {
@@ -163,7 +553,105 @@ int main() {
 
     std::cout << "Time taken with expression templates: " << duration_expr_template << " nanoseconds" << std::endl;
 
+    // 8x8 blocks (covariance-sized) exercise the runtime-dispatched vector
+    // kernels: the fused addition chain evaluates a full register per step.
+    constexpr size_t M = 8;
+    Matrix<double, M> P, Q, R;
+    for (size_t i = 0; i < M; ++i) {
+        for (size_t j = 0; j < M; ++j) {
+            P(i, j) = static_cast<double>(i * M + j);
+            Q(i, j) = static_cast<double>((i + 1) * (j + 1));
+        }
+    }
+
+    R = P + Q + P; // One pass, vectorized when cpuid allows
+
+    const char* level = simd_level() == SimdLevel::Avx512 ? "AVX-512"
+                      : simd_level() == SimdLevel::Avx2 ? "AVX2" : "scalar";
+    bool ok = true;
+    for (size_t i = 0; i < M; ++i) {
+        for (size_t j = 0; j < M; ++j) {
+            ok = ok && R(i, j) == 2 * P(i, j) + Q(i, j);
+        }
+    }
+    std::cout << "8x8 fused add via " << level << " kernels: "
+              << (ok ? "verified" : "MISMATCH") << std::endl;
 
+    // 64x64 product chain: the whole expression evaluates through the tiled
+    // accumulation path, with no temporaries for the top-level terms.
+    constexpr size_t K = 64;
+    static Matrix<double, K> KA, KB, KC, KE, KD, KD_ref;
+    for (size_t i = 0; i < K; ++i) {
+        for (size_t j = 0; j < K; ++j) {
+            KA(i, j) = static_cast<double>((i + j) % 7);
+            KB(i, j) = static_cast<double>((i * 3 + j) % 5);
+            KC(i, j) = static_cast<double>((i + 2 * j) % 3);
+            KE(i, j) = static_cast<double>((2 * i + j) % 4);
+        }
+    }
+
+    start = std::chrono::high_resolution_clock::now();
+    KD = KA * KB + KC * KE; // Two tiled multiply-accumulates into KD
+    end = std::chrono::high_resolution_clock::now();
+    auto duration_tiled = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    // Reference: naive triple loops with explicit temporaries.
+    static Matrix<double, K> T1, T2;
+    matrix_mul(KA, KB, T1);
+    matrix_mul(KC, KE, T2);
+    matrix_add(T1, T2, KD_ref);
+
+    bool mul_ok = true;
+    for (size_t i = 0; i < K; ++i) {
+        for (size_t j = 0; j < K; ++j) {
+            mul_ok = mul_ok && KD(i, j) == KD_ref(i, j);
+        }
+    }
+    std::cout << "64x64 A*B + C*E via tiled fusion: "
+              << (mul_ok ? "verified" : "MISMATCH")
+              << " in " << duration_tiled << " nanoseconds" << std::endl;
+
+    // Compile-time CSE: the type of (KA+KB)*KC + (KA+KB)*KE spells out the
+    // repeated (KA+KB); cse_assign evaluates it once and feeds the cached
+    // sum to both tiled products.
+    static Matrix<double, K> KS, KS_ref, TSUM;
+
+    start = std::chrono::high_resolution_clock::now();
+    cse_assign(KS, (KA + KB) * KC + (KA + KB) * KE);
+    end = std::chrono::high_resolution_clock::now();
+    auto duration_cse = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    matrix_add(KA, KB, TSUM);
+    matrix_mul(TSUM, KC, T1);
+    matrix_mul(TSUM, KE, T2);
+    matrix_add(T1, T2, KS_ref);
+
+    bool cse_ok = true;
+    for (size_t i = 0; i < K; ++i) {
+        for (size_t j = 0; j < K; ++j) {
+            cse_ok = cse_ok && KS(i, j) == KS_ref(i, j);
+        }
+    }
+    std::cout << "64x64 (A+B)*C + (A+B)*E with compile-time CSE: "
+              << (cse_ok ? "verified" : "MISMATCH")
+              << " in " << duration_cse << " nanoseconds" << std::endl;
+
+    // Same tree shape but different operands: the type-level match alone is
+    // not enough, the leaf-address check must reject the sharing and fall
+    // back to the plain fused path.
+    cse_assign(KS, (KA + KB) * KC + (KA + KE) * KC);
+    matrix_add(KA, KE, TSUM);
+    matrix_mul(TSUM, KC, T2);
+    matrix_add(T1, T2, KS_ref);
+
+    bool nocse_ok = true;
+    for (size_t i = 0; i < K; ++i) {
+        for (size_t j = 0; j < K; ++j) {
+            nocse_ok = nocse_ok && KS(i, j) == KS_ref(i, j);
+        }
+    }
+    std::cout << "Same-shape/different-operand tree falls back correctly: "
+              << (nocse_ok ? "verified" : "MISMATCH") << std::endl;
 
     return 0;
 }
@@ -25,13 +25,53 @@ template<class... Ts>
 struct Overloaded : Ts... { using Ts::operator()...; };
 template<class... Ts> Overloaded(Ts...) -> Overloaded<Ts...>;  // Deduction guide
 
+// fast_visit: inlinable replacement for std::visit on handler-style (void)
+// visitors. libstdc++'s std::visit dispatches through a function-pointer
+// table, an indirect call the optimizer won't inline — at decoder rates
+// that's a dozen wasted nanoseconds per event. Expanding the alternatives
+// via std::make_index_sequence instead yields index comparisons that the
+// optimizer collapses into a dense switch with the visitor bodies inlined.
+//
+// The Hot template parameter is the annotation hook for a skewed mix: name
+// the alternative index that dominates the feed and it is checked first
+// under [[likely]], so the common event never touches the switch at all.
+inline constexpr size_t kNoHotAlternative = static_cast<size_t>(-1);
+
+template<size_t Hot = kNoHotAlternative, class Visitor, class... Ts>
+void fast_visit(Visitor&& visitor, const std::variant<Ts...>& v) {
+    if constexpr (Hot != kNoHotAlternative) {
+        if (v.index() == Hot) [[likely]] {
+            visitor(*std::get_if<Hot>(&v));
+            return;
+        }
+    }
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+        ((v.index() == Is ? (visitor(*std::get_if<Is>(&v)), void()) : void()), ...);
+    }(std::index_sequence_for<Ts...>{});
+}
+
+// Specialization shape for the two-alternative variants that dominate our
+// decoders (e.g. quote-or-trade): a single predictable branch, nothing for
+// a table to buy. The first alternative is treated as the hot one.
+template<class Visitor, class T0, class T1>
+void visit2(Visitor&& visitor, const std::variant<T0, T1>& v) {
+    if (v.index() == 0) [[likely]] {
+        visitor(*std::get_if<0>(&v));
+    } else {
+        visitor(*std::get_if<1>(&v));
+    }
+}
+
 // Processor class with variant-based polymorphism
 class Processor {
 public:
     using CommandVariant = std::variant<Move, Rotate, Scale>;
 
+    // Moves dominate the command stream, so alternative 0 is the declared
+    // hot path; the overload set itself is unchanged from the std::visit
+    // version — only the dispatch strategy differs.
     void processCommand(const CommandVariant& command) const {
-        std::visit(Overloaded {
+        fast_visit<0>(Overloaded {
             [](const Move& move) { 
                 std::cout << "Processing Move Command\n"; 
                 move.execute(); 
@@ -71,5 +111,14 @@ int main() {
 
     processor.processAllCommands(commands);
 
+    // visit2 on a decoder-shaped two-alternative variant.
+    using MoveOrRotate = std::variant<Move, Rotate>;
+    for (const MoveOrRotate& command : {MoveOrRotate{Move{1, 2}}, MoveOrRotate{Rotate{180}}}) {
+        visit2(Overloaded {
+            [](const Move& move) { move.execute(); },
+            [](const Rotate& rotate) { rotate.execute(); }
+        }, command);
+    }
+
     return 0;
 }
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <numeric>
 #include <algorithm>
+#include "../cpputils/microbench.cpp"
 
 // Operation classes for virtual polymorphism
 struct IOperation {
@@ -55,92 +56,146 @@ void executeOperation(const OperationVariant& op) {
     }, op);
 }
 
-// Benchmark function with result storage
-template <typename Func>
-long long benchmark(Func func, int iterations) {
-    auto start = std::chrono::high_resolution_clock::now();
-    func();
-    auto end = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+// Hand-rolled dispatch: a fold expression over the alternative list expands
+// to an index comparison per type, which the optimizer collapses into a
+// dense switch/jump table with the operation bodies inlined — no
+// function-pointer table like libstdc++'s std::visit, so the predictor sees
+// direct branches.
+template <typename Visitor, typename... Ts, size_t... Is>
+void indexedVisit(Visitor&& visitor, const std::variant<Ts...>& v, std::index_sequence<Is...>) {
+    ((v.index() == Is ? (visitor(*std::get_if<Is>(&v)), void()) : void()), ...);
 }
 
-// Perform a t-test to check if two sets of benchmark results are significantly different
-bool t_test(const std::vector<long long>& sample1, const std::vector<long long>& sample2) {
-    int n1 = sample1.size();
-    int n2 = sample2.size();
-
-    double mean1 = std::accumulate(sample1.begin(), sample1.end(), 0.0) / n1;
-    double mean2 = std::accumulate(sample2.begin(), sample2.end(), 0.0) / n2;
-
-    double variance1 = std::accumulate(sample1.begin(), sample1.end(), 0.0, 
-                       [mean1](double sum, long long val) { return sum + (val - mean1) * (val - mean1); }) / (n1 - 1);
-    double variance2 = std::accumulate(sample2.begin(), sample2.end(), 0.0, 
-                       [mean2](double sum, long long val) { return sum + (val - mean2) * (val - mean2); }) / (n2 - 1);
-
-    double t_stat = std::abs(mean1 - mean2) / std::sqrt((variance1 / n1) + (variance2 / n2));
-    double critical_value = 2.101;  // Approximate value for a 95% confidence level with large sample size
+template <typename Visitor, typename... Ts>
+void fastVisit(Visitor&& visitor, const std::variant<Ts...>& v) {
+    indexedVisit(visitor, v, std::index_sequence_for<Ts...>{});
+}
 
-    return t_stat > critical_value;
+void executeOperationFast(const OperationVariant& op) {
+    fastVisit([](const auto& operation) {
+        using T = std::decay_t<decltype(operation)>;
+        if constexpr (std::is_same_v<T, Move>) {
+            double result = operation.x + operation.y;  // simulate work
+        } else if constexpr (std::is_same_v<T, Rotate>) {
+            double radians = operation.angle * 3.141592653589793 / 180.0;  // simulate work
+        } else if constexpr (std::is_same_v<T, Scale>) {
+            double result = operation.factor * operation.factor;  // simulate work
+        }
+    }, op);
 }
 
-int main() {
-    constexpr int iterations = 1000000;
-    constexpr int trials = 100;
-
-    // Store results for each trial
-    std::vector<long long> virtual_durations;
-    std::vector<long long> visit_durations;
-
-    // Run multiple trials for virtual function-based polymorphism
-    for (int trial = 0; trial < trials; ++trial) {
-        std::vector<IOperation*> virtualOperations;
-        for (int i = 0; i < iterations / 3; ++i) {
-            virtualOperations.push_back(new MoveOperation(10.0, 20.0));
-            virtualOperations.push_back(new RotateOperation(90.0));
-            virtualOperations.push_back(new ScaleOperation(1.5));
+// Batch mode: group the variants by alternative index first, then run one
+// monomorphic loop per type. The grouping pass is linear and branch-free-ish;
+// after it, every dispatch site sees exactly one type, so the operation mix
+// (however skewed) can no longer starve the branch predictor.
+void executeBatchSorted(const std::vector<OperationVariant>& ops) {
+    std::vector<const Move*> moves;
+    std::vector<const Rotate*> rotates;
+    std::vector<const Scale*> scales;
+    moves.reserve(ops.size());
+    rotates.reserve(ops.size());
+    scales.reserve(ops.size());
+
+    for (const auto& op : ops) {
+        switch (op.index()) {
+            case 0: moves.push_back(std::get_if<Move>(&op)); break;
+            case 1: rotates.push_back(std::get_if<Rotate>(&op)); break;
+            case 2: scales.push_back(std::get_if<Scale>(&op)); break;
         }
+    }
 
-        virtual_durations.push_back(benchmark([&]() {
-            for (const auto* op : virtualOperations) {
-                op->execute();
-            }
-        }, iterations));
+    for (const Move* m : moves) {
+        double result = m->x + m->y;  // simulate work
+    }
+    for (const Rotate* r : rotates) {
+        double radians = r->angle * 3.141592653589793 / 180.0;  // simulate work
+    }
+    for (const Scale* s : scales) {
+        double result = s->factor * s->factor;  // simulate work
+    }
+}
 
-        for (auto* op : virtualOperations) {
-            delete op;
+// Benchmarks on the shared harness: calibration, warmup, median-of-N with
+// MAD outlier rejection and the cycles column all come from microbench.cpp
+// (this file used to carry its own benchmark() template and a t-test — the
+// harness's robust statistics replace both). Inputs are built once in
+// function-local statics so only the dispatch loop is timed.
+
+constexpr int kNumOps = 4096;
+
+static const std::vector<IOperation*>& virtualOps() {
+    static const std::vector<IOperation*> ops = [] {
+        std::vector<IOperation*> built;
+        for (int i = 0; i < kNumOps / 3; ++i) {
+            built.push_back(new MoveOperation(10.0, 20.0));
+            built.push_back(new RotateOperation(90.0));
+            built.push_back(new ScaleOperation(1.5));
         }
-    }
+        return built;
+    }();
+    return ops;
+}
 
-    // Run multiple trials for variant-based polymorphism
-    for (int trial = 0; trial < trials; ++trial) {
-        std::vector<OperationVariant> variantOperations;
-        for (int i = 0; i < iterations / 3; ++i) {
-            variantOperations.emplace_back(Move{10.0, 20.0});
-            variantOperations.emplace_back(Rotate{90.0});
-            variantOperations.emplace_back(Scale{1.5});
+static const std::vector<OperationVariant>& variantOps() {
+    static const std::vector<OperationVariant> ops = [] {
+        std::vector<OperationVariant> built;
+        for (int i = 0; i < kNumOps / 3; ++i) {
+            built.emplace_back(Move{10.0, 20.0});
+            built.emplace_back(Rotate{90.0});
+            built.emplace_back(Scale{1.5});
         }
+        return built;
+    }();
+    return ops;
+}
 
-        visit_durations.push_back(benchmark([&]() {
-            for (const auto& op : variantOperations) {
-                executeOperation(op);
-            }
-        }, iterations));
+void bmVirtualDispatch(size_t iterations) {
+    const auto& ops = virtualOps();
+    size_t idx = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        ops[idx]->execute();
+        if (++idx == ops.size()) idx = 0;
     }
+    doNotOptimize(idx);
+}
 
-    // Calculate mean durations
-    double mean_virtual = std::accumulate(virtual_durations.begin(), virtual_durations.end(), 0.0) / trials;
-    double mean_visit = std::accumulate(visit_durations.begin(), visit_durations.end(), 0.0) / trials;
+void bmStdVisit(size_t iterations) {
+    const auto& ops = variantOps();
+    size_t idx = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        executeOperation(ops[idx]);
+        if (++idx == ops.size()) idx = 0;
+    }
+    doNotOptimize(idx);
+}
 
-    // Display results
-    std::cout << "Average virtual function polymorphism: " << mean_virtual << " microseconds\n";
-    std::cout << "Average std::visit-based polymorphism: " << mean_visit << " microseconds\n";
+void bmIndexSwitchDispatch(size_t iterations) {
+    const auto& ops = variantOps();
+    size_t idx = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        executeOperationFast(ops[idx]);
+        if (++idx == ops.size()) idx = 0;
+    }
+    doNotOptimize(idx);
+}
 
-    // Perform t-test to check statistical significance
-    if (t_test(virtual_durations, visit_durations)) {
-        std::cout << "The performance difference is statistically significant.\n";
-    } else {
-        std::cout << "The performance difference is NOT statistically significant.\n";
+// Whole passes over the operation mix: the grouping pass is charged to the
+// measurement — it's part of the real cost.
+void bmBatchSorted(size_t iterations) {
+    const auto& ops = variantOps();
+    for (size_t done = 0; done < iterations; done += ops.size()) {
+        executeBatchSorted(ops);
     }
+}
+
+MICROBENCHMARK(bmVirtualDispatch);
+MICROBENCHMARK(bmStdVisit);
+MICROBENCHMARK(bmIndexSwitchDispatch);
+MICROBENCHMARK(bmBatchSorted);
 
+int main() {
+    const std::vector<BenchResult> results = BenchmarkRegistry::instance().runAll(std::cout);
+    std::cout << "\n";
+    BenchmarkRegistry::writeJson(results, std::cout);
     return 0;
 }
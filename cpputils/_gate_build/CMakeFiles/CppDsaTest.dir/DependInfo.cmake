@@ -0,0 +1,32 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/cpputils/tests/test_async_binary_log.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_async_binary_log.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_async_binary_log.cpp.o.d"
+  "/root/repo/cpputils/tests/test_cpu_topology.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_cpu_topology.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_cpu_topology.cpp.o.d"
+  "/root/repo/cpputils/tests/test_ebr.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_ebr.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_ebr.cpp.o.d"
+  "/root/repo/cpputils/tests/test_intrusive_ll.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_intrusive_ll.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_intrusive_ll.cpp.o.d"
+  "/root/repo/cpputils/tests/test_latency_probe.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_latency_probe.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_latency_probe.cpp.o.d"
+  "/root/repo/cpputils/tests/test_lru_cache.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_lru_cache.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_lru_cache.cpp.o.d"
+  "/root/repo/cpputils/tests/test_main.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_main.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_main.cpp.o.d"
+  "/root/repo/cpputils/tests/test_microbench.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_microbench.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_microbench.cpp.o.d"
+  "/root/repo/cpputils/tests/test_tsc_clock.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_tsc_clock.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_tsc_clock.cpp.o.d"
+  "/root/repo/cpputils/tests/test_wub_open_addressing_hashtable.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_wub_open_addressing_hashtable.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_wub_open_addressing_hashtable.cpp.o.d"
+  "/root/repo/cpputils/tests/test_wub_ring_buffer.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_wub_ring_buffer.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_wub_ring_buffer.cpp.o.d"
+  "/root/repo/cpputils/tests/test_wub_shared_ptr.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_wub_shared_ptr.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_wub_shared_ptr.cpp.o.d"
+  "/root/repo/cpputils/tests/test_wub_unique_ptr.cpp" "CMakeFiles/CppDsaTest.dir/tests/test_wub_unique_ptr.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/tests/test_wub_unique_ptr.cpp.o.d"
+  "/root/repo/cpputils/wub_unique_ptr.cpp" "CMakeFiles/CppDsaTest.dir/wub_unique_ptr.cpp.o" "gcc" "CMakeFiles/CppDsaTest.dir/wub_unique_ptr.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
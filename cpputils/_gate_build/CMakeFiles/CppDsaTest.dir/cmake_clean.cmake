@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/CppDsaTest.dir/tests/test_async_binary_log.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_async_binary_log.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_cpu_topology.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_cpu_topology.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_ebr.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_ebr.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_intrusive_ll.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_intrusive_ll.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_latency_probe.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_latency_probe.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_lru_cache.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_lru_cache.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_main.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_main.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_microbench.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_microbench.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_tsc_clock.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_tsc_clock.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_wub_open_addressing_hashtable.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_wub_open_addressing_hashtable.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_wub_ring_buffer.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_wub_ring_buffer.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_wub_shared_ptr.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_wub_shared_ptr.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/tests/test_wub_unique_ptr.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/tests/test_wub_unique_ptr.cpp.o.d"
+  "CMakeFiles/CppDsaTest.dir/wub_unique_ptr.cpp.o"
+  "CMakeFiles/CppDsaTest.dir/wub_unique_ptr.cpp.o.d"
+  "CppDsaTest"
+  "CppDsaTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CppDsaTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
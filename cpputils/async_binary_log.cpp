@@ -0,0 +1,155 @@
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "wub_ring_buffer.cpp"
+
+// Asynchronous binary logging: the hot thread writes a compact record (call
+// site ID + raw 64-bit argument slots) into an SPSC LocklessRingBuffer and
+// returns immediately; a drainer thread pops records in batches and does the
+// formatting and sink I/O through spdlog. Deferred formatting keeps the log
+// call to a few stores — no fmt parsing, no allocation, no file write on the
+// caller's path. The format string and argument types are captured once per
+// call site via a static registration, nanolog-style.
+
+struct BinaryLogRecord {
+    static constexpr size_t kMaxArgs = 4;
+
+    uint64_t timestamp_ns;
+    uint32_t site_id;
+    uint32_t arg_count;
+    std::array<uint64_t, kMaxArgs> args;
+};
+
+class AsyncBinaryLogger {
+public:
+    explicit AsyncBinaryLogger(std::shared_ptr<spdlog::logger> sink, size_t ring_size = 65536)
+        : sink_(std::move(sink)), ring_(ring_size), running_(true) {
+        drainer_ = std::thread([this] { drainLoop(); });
+    }
+
+    ~AsyncBinaryLogger() { stop(); }
+
+    // Hot path: pack the arguments into raw slots and push one record. On a
+    // full ring the record is dropped and counted — blocking the caller on
+    // the drainer would defeat the point.
+    template<typename... Args>
+    void log(uint32_t site_id, const Args&... args) {
+        static_assert(sizeof...(Args) <= BinaryLogRecord::kMaxArgs,
+                      "binary log records carry at most 4 arguments");
+        BinaryLogRecord record;
+        record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        record.site_id = site_id;
+        record.arg_count = sizeof...(Args);
+        size_t slot = 0;
+        ((record.args[slot++] = encode(args)), ...);
+        if (!ring_.push(record)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // One-time per call site: remember the format string and a thunk that
+    // knows how to decode this site's argument types. The `args` themselves
+    // are only used for deduction.
+    template<typename... Args>
+    uint32_t registerSiteFor(const char* fmt, const Args&...) {
+        std::lock_guard<std::mutex> lock(sitesMutex_);
+        sites_.push_back({fmt, &formatThunk<Args...>});
+        return static_cast<uint32_t>(sites_.size() - 1);
+    }
+
+    // Drain everything queued so far and stop the drainer thread.
+    void stop() {
+        if (running_.exchange(false) && drainer_.joinable()) {
+            drainer_.join();
+        }
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Site {
+        const char* fmt;
+        void (*format)(spdlog::logger&, const char*, const BinaryLogRecord&);
+    };
+
+    // Arguments travel as raw 64-bit slots: integers widen, doubles are
+    // bit-cast, and string literals go by pointer (their storage is static).
+    template<typename T>
+    static uint64_t encode(const T& value) {
+        using D = std::decay_t<T>; // Arrays (string literals) decay to pointers
+        if constexpr (std::is_floating_point_v<D>) {
+            return std::bit_cast<uint64_t>(static_cast<double>(value));
+        } else if constexpr (std::is_pointer_v<D>) {
+            return reinterpret_cast<uint64_t>(static_cast<const void*>(value));
+        } else {
+            static_assert(std::is_integral_v<D> || std::is_enum_v<D>,
+                          "only integral, floating, and pointer args are loggable");
+            return static_cast<uint64_t>(value);
+        }
+    }
+
+    template<typename T>
+    static T decode(uint64_t raw) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(std::bit_cast<double>(raw));
+        } else if constexpr (std::is_pointer_v<T>) {
+            return reinterpret_cast<T>(raw);
+        } else {
+            return static_cast<T>(raw);
+        }
+    }
+
+    template<typename... Args>
+    static void formatThunk(spdlog::logger& logger, const char* fmt,
+                            const BinaryLogRecord& record) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            logger.info(fmt::runtime(fmt), decode<std::decay_t<Args>>(record.args[I])...);
+        }(std::index_sequence_for<Args...>{});
+    }
+
+    void drainLoop() {
+        BinaryLogRecord batch[256];
+        while (running_.load(std::memory_order_relaxed) || !ring_.is_empty()) {
+            const size_t n = ring_.pop_n(batch, std::size(batch));
+            if (n == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                Site site;
+                {
+                    std::lock_guard<std::mutex> lock(sitesMutex_);
+                    site = sites_[batch[i].site_id];
+                }
+                site.format(*sink_, site.fmt, batch[i]);
+            }
+        }
+        sink_->flush();
+    }
+
+    std::shared_ptr<spdlog::logger> sink_;
+    LocklessRingBuffer<BinaryLogRecord> ring_;
+    std::mutex sitesMutex_;
+    std::vector<Site> sites_;
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> running_;
+    std::thread drainer_;
+};
+
+// Call-site macro: registers the format string and argument types on first
+// execution, then every pass is just the binary push.
+//
+//     ASYNC_LOG(logger, "fill {} @ {}", order_id, price);
+#define ASYNC_LOG(alogger, fmtstr, ...)                                              \
+    do {                                                                             \
+        static const uint32_t _async_log_site =                                      \
+            (alogger).registerSiteFor(fmtstr __VA_OPT__(, ) __VA_ARGS__);            \
+        (alogger).log(_async_log_site __VA_OPT__(, ) __VA_ARGS__);                   \
+    } while (0)
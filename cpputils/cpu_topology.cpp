@@ -0,0 +1,182 @@
+#include <sched.h>
+#include <unistd.h>
+#include <cstddef>
+#include <new>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if __has_include(<numa.h>)
+#include <numa.h>
+#define CPPUTILS_HAVE_NUMA 1
+#endif
+
+// Topology-aware thread and memory placement. rdtscp.cpp has long pinned
+// itself to core 0 with a private helper; this module promotes that into
+// something the pipelines can share: enumerate cores and NUMA nodes, pin
+// threads from a declarative placement spec, and allocate queue storage on
+// the node local to its consumer. A dequeue that crosses the socket
+// interconnect costs roughly 2.5x a node-local one, so placement is worth
+// stating explicitly rather than leaving to the scheduler.
+
+// Pin the calling thread to one core. Promoted from the private
+// set_cpu_affinity in rdtscp.cpp; returns false instead of printing so
+// callers choose how loud a failed pin should be.
+inline bool pin_current_thread(int core_id) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core_id, &cpuset);
+    return sched_setaffinity(0, sizeof(cpu_set_t), &cpuset) == 0;
+}
+
+// Snapshot of the machine: every online CPU and the NUMA node it belongs
+// to. Without libnuma (or on a non-NUMA box) everything reports node 0,
+// so callers never need their own fallback.
+class CpuTopology {
+public:
+    struct Cpu {
+        int id;
+        int node;
+    };
+
+    CpuTopology() {
+        const int count = static_cast<int>(std::thread::hardware_concurrency());
+        for (int cpu = 0; cpu < count; ++cpu) {
+            const int node = nodeOf(cpu);
+            cpus_.push_back({cpu, node});
+            if (node + 1 > num_nodes_) {
+                num_nodes_ = node + 1;
+            }
+        }
+    }
+
+    static int nodeOf(int cpu) {
+#ifdef CPPUTILS_HAVE_NUMA
+        if (numa_available() >= 0) {
+            const int node = numa_node_of_cpu(cpu);
+            if (node >= 0) {
+                return node;
+            }
+        }
+#endif
+        return 0;
+    }
+
+    const std::vector<Cpu>& cpus() const { return cpus_; }
+    int numNodes() const { return num_nodes_; }
+
+    std::vector<int> cpusOnNode(int node) const {
+        std::vector<int> result;
+        for (const Cpu& cpu : cpus_) {
+            if (cpu.node == node) {
+                result.push_back(cpu.id);
+            }
+        }
+        return result;
+    }
+
+private:
+    std::vector<Cpu> cpus_;
+    int num_nodes_ = 0;
+};
+
+// Fixed-size array whose backing pages live on one NUMA node
+// (numa_alloc_onnode). Size a ring's slots with this on the consumer's node
+// and every dequeue stays node-local. Falls back to the global allocator
+// when libnuma is unavailable.
+template<typename T>
+class NumaArray {
+public:
+    NumaArray(size_t count, int node) : count_(count), node_(node) {
+#ifdef CPPUTILS_HAVE_NUMA
+        if (numa_available() >= 0) {
+            data_ = static_cast<T*>(numa_alloc_onnode(count * sizeof(T), node));
+            from_numa_ = data_ != nullptr;
+        }
+#endif
+        if (data_ == nullptr) {
+            data_ = static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        for (size_t i = 0; i < count_; ++i) {
+            new (data_ + i) T();
+        }
+    }
+
+    ~NumaArray() {
+        for (size_t i = 0; i < count_; ++i) {
+            data_[i].~T();
+        }
+#ifdef CPPUTILS_HAVE_NUMA
+        if (from_numa_) {
+            numa_free(data_, count_ * sizeof(T));
+            return;
+        }
+#endif
+        ::operator delete(data_);
+    }
+
+    NumaArray(const NumaArray&) = delete;
+    NumaArray& operator=(const NumaArray&) = delete;
+
+    T& operator[](size_t index) { return data_[index]; }
+    const T& operator[](size_t index) const { return data_[index]; }
+    size_t size() const { return count_; }
+    int node() const { return node_; }
+
+private:
+    size_t count_;
+    int node_;
+    T* data_ = nullptr;
+    bool from_numa_ = false;
+};
+
+// Declarative placement: name each thread role and the core it runs on up
+// front, pin from inside the thread by role, and get a report of which
+// roles will reach the queue storage across a node boundary.
+class PlacementSpec {
+public:
+    struct Entry {
+        std::string role;
+        int cpu;
+    };
+
+    void place(const std::string& role, int cpu) { entries_.push_back({role, cpu}); }
+
+    int cpuFor(const std::string& role) const {
+        for (const Entry& entry : entries_) {
+            if (entry.role == role) {
+                return entry.cpu;
+            }
+        }
+        return -1;
+    }
+
+    // Pin the calling thread to the core its role was placed on.
+    bool pinCurrentThread(const std::string& role) const {
+        const int cpu = cpuFor(role);
+        return cpu >= 0 && pin_current_thread(cpu);
+    }
+
+    // Print every role's core and node, flagging the ones that sit on a
+    // different node from `memory_node` (where the queue storage lives).
+    // Returns the number of cross-node roles.
+    int reportCrossNode(int memory_node, std::ostream& out) const {
+        int crossers = 0;
+        for (const Entry& entry : entries_) {
+            const int node = CpuTopology::nodeOf(entry.cpu);
+            out << entry.role << ": cpu " << entry.cpu << " (node " << node << ")";
+            if (node != memory_node) {
+                out << " [cross-node to storage on node " << memory_node << "]";
+                ++crossers;
+            }
+            out << "\n";
+        }
+        return crossers;
+    }
+
+    const std::vector<Entry>& entries() const { return entries_; }
+
+private:
+    std::vector<Entry> entries_;
+};
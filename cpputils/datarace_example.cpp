@@ -1,6 +1,9 @@
 #include <iostream>
 #include <thread>
 #include <atomic>
+#include <vector>
+
+#include "ebr.cpp"
 
 int shared_data = 0; // change to atomic to eliminate data race
 
@@ -10,6 +13,42 @@ void increment() {
     }
 }
 
+// The same class of bug one level up: a shared pointer swapped by a writer
+// while readers dereference it. Deleting the old object immediately is a
+// use-after-free; a global mutex fixes it by making readers pay for every
+// access. Epoch-based reclamation (ebr.cpp) fixes it without a reader-side
+// lock: readers pin an epoch guard, the writer retires the old object, and
+// it is freed only after every pinned reader has moved on.
+struct Config {
+    int version;
+    double threshold;
+};
+
+std::atomic<Config*> active_config{nullptr};
+std::atomic<bool> config_done{false};
+
+void config_reader() {
+    while (!config_done.load(std::memory_order_acquire)) {
+        EbrGuard guard; // Two stores on a thread-private line; no lock
+        const Config* config = active_config.load(std::memory_order_acquire);
+        if (config->version < 0 || config->threshold < 0.0) {
+            std::cerr << "Read a reclaimed config!\n";
+            std::abort();
+        }
+    }
+}
+
+void config_writer(int updates) {
+    for (int i = 1; i <= updates; ++i) {
+        Config* next = new Config{i, i * 0.5};
+        Config* old = active_config.exchange(next, std::memory_order_acq_rel);
+        EbrDomain::instance().retire(old); // Freed once readers quiesce
+        if ((i & 63) == 0) {
+            EbrDomain::instance().tryReclaim();
+        }
+    }
+}
+
 int main() {
     std::thread t1(increment);
     std::thread t2(increment);
@@ -18,5 +57,23 @@ int main() {
     t2.join();
 
     std::cout << "Final value of shared_data: " << shared_data << std::endl;
+
+    // Epoch-protected pointer swap: no mutex, no use-after-free.
+    active_config.store(new Config{0, 0.0});
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back(config_reader);
+    }
+    std::thread writer(config_writer, 10000);
+    writer.join();
+    config_done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    delete active_config.load();
+    while (EbrDomain::instance().tryReclaim() > 0 ||
+           EbrDomain::instance().pending() > 0) {
+    }
+    std::cout << "Config updated 10000 times with no reader lock.\n";
     return 0;
 }
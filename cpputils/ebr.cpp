@@ -0,0 +1,150 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Epoch-based reclamation: the third answer (after wub_shared_ptr's atomic
+// refcounts and hazard pointers) to "when may this object be freed?", tuned
+// for read-mostly structures. A reader brackets its critical section with
+// an EbrGuard — two stores to a thread-private line, no shared counter, no
+// per-pointer protection like hazard pointers. Writers retire() replaced
+// objects into the current epoch's limbo list; the epoch only advances
+// once every pinned reader has caught up to it, and a list is freed two
+// advances after it was filled, by which point no reader can still hold a
+// reference into it.
+class EbrDomain {
+public:
+    static constexpr size_t kMaxThreads = 128;
+    static constexpr uint64_t kQuiescent = UINT64_MAX;
+
+    struct Slot {
+        // kQuiescent outside any critical section; the observed global
+        // epoch while pinned.
+        std::atomic<uint64_t> epoch{kQuiescent};
+        std::atomic<bool> in_use{false};
+        char padding[64 - sizeof(epoch) - sizeof(in_use)];
+    };
+
+    static EbrDomain& instance() {
+        static EbrDomain domain;
+        return domain;
+    }
+
+    // Claim a slot for the calling thread; cached in a thread_local so the
+    // CAS scan runs once per thread, not per pin.
+    Slot* acquireSlot() {
+        thread_local Slot* mySlot = [this] {
+            for (auto& slot : slots_) {
+                bool expected = false;
+                if (slot.in_use.compare_exchange_strong(expected, true)) {
+                    return &slot;
+                }
+            }
+            throw std::runtime_error("EbrDomain: out of epoch slots");
+        }();
+        return mySlot;
+    }
+
+    // Enter a read-side critical section: publish the epoch this thread is
+    // reading under. Publish-then-verify mirrors HazardPtr — the store must
+    // be visible before we trust the epoch we observed, or a concurrent
+    // advance could miss this reader.
+    Slot* pin() {
+        Slot* slot = acquireSlot();
+        uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+        for (;;) {
+            slot->epoch.store(epoch, std::memory_order_seq_cst);
+            const uint64_t recheck = global_epoch_.load(std::memory_order_seq_cst);
+            if (recheck == epoch) {
+                break;
+            }
+            epoch = recheck;
+        }
+        return slot;
+    }
+
+    static void unpin(Slot* slot) {
+        slot->epoch.store(kQuiescent, std::memory_order_release);
+    }
+
+    // Defer deletion of `ptr` until every reader pinned now has unpinned:
+    // it joins the current epoch's limbo list, freed two epoch advances
+    // from now.
+    template<typename T>
+    void retire(T* ptr) {
+        retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    void retire(void* ptr, void (*deleter)(void*)) {
+        std::lock_guard<std::mutex> lock(limboMutex_);
+        limbo_[global_epoch_.load(std::memory_order_relaxed) % 3].push_back(
+            {ptr, deleter});
+        ++pending_;
+    }
+
+    // Advance the epoch if every pinned thread has observed the current
+    // one, then free the limbo list that became unreachable. Returns the
+    // number of objects freed; call it from a maintenance point (writers
+    // typically, after a batch of retires). Fully draining the limbo lists
+    // takes up to three calls with no readers pinned.
+    size_t tryReclaim() {
+        std::lock_guard<std::mutex> lock(limboMutex_);
+        const uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+        for (const Slot& slot : slots_) {
+            if (!slot.in_use.load(std::memory_order_acquire)) {
+                continue;
+            }
+            const uint64_t seen = slot.epoch.load(std::memory_order_acquire);
+            if (seen != kQuiescent && seen != epoch) {
+                return 0; // A reader is still in an older epoch
+            }
+        }
+        global_epoch_.store(epoch + 1, std::memory_order_seq_cst);
+
+        // Epoch e+1's retirees reuse this bucket; everything in it was
+        // retired in epoch e-1, and no reader from e-1 remains.
+        std::vector<Retired>& expired = limbo_[(epoch + 1) % 3];
+        const size_t freed = expired.size();
+        for (const Retired& r : expired) {
+            r.deleter(r.ptr);
+        }
+        expired.clear();
+        pending_ -= freed;
+        return freed;
+    }
+
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(limboMutex_);
+        return pending_;
+    }
+
+private:
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    std::array<Slot, kMaxThreads> slots_;
+    std::atomic<uint64_t> global_epoch_{0};
+    mutable std::mutex limboMutex_;
+    std::array<std::vector<Retired>, 3> limbo_;
+    size_t pending_ = 0;
+};
+
+// RAII read-side critical section. Objects loaded from shared pointers
+// while a guard is alive stay valid until the guard is destroyed, however
+// many writers retire() them meanwhile.
+class EbrGuard {
+public:
+    EbrGuard() : slot_(EbrDomain::instance().pin()) {}
+    ~EbrGuard() { EbrDomain::unpin(slot_); }
+
+    EbrGuard(const EbrGuard&) = delete;
+    EbrGuard& operator=(const EbrGuard&) = delete;
+
+private:
+    EbrDomain::Slot* slot_;
+};
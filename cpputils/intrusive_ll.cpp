@@ -36,8 +36,47 @@ struct ListHead {
     bool empty() const {
         return next == this;
     }
+
+    // Relink the chain [first, last] (inclusive) after `this`, detaching it
+    // from whatever list it was on. O(1) pointer swaps regardless of how many
+    // nodes the chain holds — moving a whole runnable-set between lists costs
+    // the same as moving one node.
+    void splice(ListHead *first, ListHead *last) {
+        // Close the gap in the source list
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+
+        // Stitch the chain in after this head
+        last->next = next;
+        first->prev = this;
+        next->prev = last;
+        next = first;
+    }
+
+    // Move every node of `other` onto the front of this list, leaving
+    // `other` empty.
+    void splice_all(ListHead *other) {
+        if (!other->empty()) {
+            splice(other->next, other->prev);
+        }
+    }
 };
 
+// Walk the list issuing a prefetch two hops ahead while visiting each node.
+// A plain traversal is one dependent cache miss per node; prefetching
+// next->next overlaps the miss for node N+2 with the visit of node N.
+// `visit` receives each ListHead* between head->next and head (exclusive),
+// and may remove the visited node (the successor is read before the call).
+template <typename Visit>
+void for_each_prefetch(ListHead *head, Visit visit) {
+    for (ListHead *pos = head->next; pos != head;) {
+        ListHead *next = pos->next;
+        __builtin_prefetch(next->next, 0, 1);
+        visit(pos);
+        pos = next;
+    }
+}
+
 // Define a templated ListEntry to link any type of struct/class
 template <typename T>
 struct ListEntry {
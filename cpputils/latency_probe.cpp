@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "tsc_clock.cpp"
+
+// Hot-path latency instrumentation: ScopedProbe records an rdtscp delta into
+// a per-thread log-linear histogram (HDR-style — exact buckets up to 2^precision,
+// then `1 << kSubBucketBits` sub-buckets per power of two above that), so the
+// record path is a cycle read, a bit scan, and one relaxed increment on a
+// thread-private counter. A background reporter thread sums the per-thread
+// histograms and emits p50/p99/p999 through spdlog; probes never take a lock
+// or allocate after thread registration.
+
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;              // 32 sub-buckets per octave
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    // Octave 0 holds the exact buckets below kSubBuckets; octaves 1..59
+    // cover msb positions kSubBucketBits..63, so every uint64 value (even
+    // a wrapped negative delta) maps in range.
+    static constexpr int kOctaves = 64 - kSubBucketBits + 1;
+    static constexpr int kBucketCount = kOctaves * kSubBuckets;
+
+    void record(uint64_t value_ns) {
+        counts_[bucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Merge this histogram into `sums` and reset it (interval semantics: each
+    // reporter tick sees only samples recorded since the previous tick).
+    uint64_t drainInto(std::array<uint64_t, kBucketCount>& sums) {
+        uint64_t drained = 0;
+        for (int i = 0; i < kBucketCount; ++i) {
+            const uint64_t n = counts_[i].exchange(0, std::memory_order_relaxed);
+            sums[i] += n;
+            drained += n;
+        }
+        total_.fetch_sub(drained, std::memory_order_relaxed);
+        return drained;
+    }
+
+    uint64_t total() const { return total_.load(std::memory_order_relaxed); }
+
+    static int bucketIndex(uint64_t value_ns) {
+        if (value_ns < kSubBuckets) {
+            return static_cast<int>(value_ns); // Exact buckets below one octave
+        }
+        const int msb = 63 - __builtin_clzll(value_ns);
+        const int octave = msb - kSubBucketBits + 1;
+        const int sub = static_cast<int>(value_ns >> (octave - 1)) & (kSubBuckets - 1);
+        return octave * kSubBuckets + sub;
+    }
+
+    // Representative (midpoint) value for a bucket, for percentile readout.
+    static uint64_t bucketValue(int index) {
+        const int octave = index / kSubBuckets;
+        const int sub = index % kSubBuckets;
+        if (octave == 0) {
+            return static_cast<uint64_t>(sub);
+        }
+        const uint64_t base = (static_cast<uint64_t>(kSubBuckets) + sub) << (octave - 1);
+        return base + (1ull << (octave - 1)) / 2;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> counts_{};
+    std::atomic<uint64_t> total_{0};
+};
+
+// Registry of named probe sites. Each (site, thread) pair gets its own
+// histogram; the reporter walks all of them. Registration is mutex-guarded
+// but happens once per thread per site, never on the record path.
+class ProbeRegistry {
+public:
+    static ProbeRegistry& instance() {
+        static ProbeRegistry registry;
+        return registry;
+    }
+
+    // Thread-local histogram for the site named `name`. The returned pointer
+    // is stable for the process lifetime (histograms are never freed, so a
+    // probe outliving its thread's exit still has valid counters to read).
+    LatencyHistogram* histogramFor(const char* name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto* hist = new LatencyHistogram();
+        sites_.push_back({name, hist});
+        return hist;
+    }
+
+    // Aggregate every thread's histogram per site and log percentiles.
+    void report(spdlog::logger& logger) {
+        std::vector<Site> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            snapshot = sites_;
+        }
+
+        // Group by site name; sites_ is tiny (sites x threads), linear is fine.
+        std::vector<std::string> seen;
+        for (const Site& site : snapshot) {
+            if (std::find(seen.begin(), seen.end(), site.name) != seen.end()) {
+                continue;
+            }
+            seen.push_back(site.name);
+
+            std::array<uint64_t, LatencyHistogram::kBucketCount> sums{};
+            uint64_t total = 0;
+            for (const Site& other : snapshot) {
+                if (other.name == site.name) {
+                    total += other.histogram->drainInto(sums);
+                }
+            }
+            if (total == 0) {
+                continue;
+            }
+            logger.info("{}: n={} p50={}ns p99={}ns p999={}ns",
+                        site.name, total,
+                        percentile(sums, total, 0.50),
+                        percentile(sums, total, 0.99),
+                        percentile(sums, total, 0.999));
+        }
+    }
+
+    // Run report() every `interval_ms` until stop_reporter() is called.
+    void start_reporter(std::shared_ptr<spdlog::logger> logger, int interval_ms = 1000) {
+        bool expected = false;
+        if (!reporter_running_.compare_exchange_strong(expected, true)) {
+            return;
+        }
+        reporter_thread_ = std::thread([this, logger, interval_ms] {
+            while (reporter_running_.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+                report(*logger);
+            }
+        });
+    }
+
+    void stop_reporter() {
+        if (reporter_running_.exchange(false) && reporter_thread_.joinable()) {
+            reporter_thread_.join();
+        }
+    }
+
+private:
+    struct Site {
+        std::string name;
+        LatencyHistogram* histogram;
+    };
+
+    static uint64_t percentile(const std::array<uint64_t, LatencyHistogram::kBucketCount>& sums,
+                               uint64_t total, double q) {
+        const uint64_t rank = static_cast<uint64_t>(total * q);
+        uint64_t seen = 0;
+        for (int i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+            seen += sums[i];
+            if (seen > rank) {
+                return LatencyHistogram::bucketValue(i);
+            }
+        }
+        return LatencyHistogram::bucketValue(LatencyHistogram::kBucketCount - 1);
+    }
+
+    ~ProbeRegistry() { stop_reporter(); }
+
+    std::mutex mutex_;
+    std::vector<Site> sites_;
+    std::atomic<bool> reporter_running_{false};
+    std::thread reporter_thread_;
+};
+
+// RAII probe: records the cycle delta between construction and destruction
+// into this thread's histogram for the site. Intended usage:
+//
+//     void on_packet() {
+//         LATENCY_PROBE("udp_rx");
+//         ... hot path ...
+//     }
+//
+// The thread_local lookup resolves to a cached pointer after the first hit,
+// so steady-state cost is two rdtscp reads and one relaxed increment.
+class ScopedProbe {
+public:
+    explicit ScopedProbe(LatencyHistogram* histogram)
+        : histogram_(histogram), start_cycles_(TscClock::cycles()) {}
+
+    ~ScopedProbe() {
+        const uint64_t delta = TscClock::cycles() - start_cycles_;
+        histogram_->record(TscClock::instance().to_ns(delta));
+    }
+
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+private:
+    LatencyHistogram* histogram_;
+    uint64_t start_cycles_;
+};
+
+#define LATENCY_PROBE(site_name)                                                 \
+    static thread_local LatencyHistogram* _probe_hist_##__LINE__ =               \
+        ProbeRegistry::instance().histogramFor(site_name);                       \
+    ScopedProbe _probe_##__LINE__(_probe_hist_##__LINE__)
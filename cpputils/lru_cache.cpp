@@ -0,0 +1,109 @@
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "intrusive_ll.cpp"
+#include "wub_open_addressing_hashtable.cpp"
+
+// Bounded LRU cache composed from the pieces already in this directory: the
+// HashTable maps keys to nodes, and every node is simultaneously linked into
+// an intrusive ListHead recency list. One node carries both roles, so there
+// is no per-entry allocation: all nodes come from a pool sized at
+// construction, touch is an unlink/relink, and eviction pops the list tail.
+template<typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>>
+class LruCache {
+public:
+    explicit LruCache(size_t capacity)
+        // Table sized to twice the node count keeps the load factor at 0.5,
+        // so the HashTable never rehashes after construction.
+        : capacity_(capacity), nodes_(capacity), table_(capacity * 2) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Capacity must be greater than 0");
+        }
+        for (Node& node : nodes_) {
+            node.lru.add_tail(&free_);
+        }
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    // Look up `key`, marking it most recently used on a hit.
+    std::optional<ValueType> get(const KeyType& key) {
+        auto found = table_.find(key);
+        if (!found.has_value()) {
+            return std::nullopt;
+        }
+        Node* node = *found;
+        touch(node);
+        return node->value;
+    }
+
+    // Insert or update `key`. At capacity, the least recently used entry is
+    // evicted to make room; its node is reused in place.
+    void put(const KeyType& key, const ValueType& value) {
+        auto found = table_.find(key);
+        if (found.has_value()) {
+            Node* node = *found;
+            node->value = value;
+            touch(node);
+            return;
+        }
+
+        Node* node;
+        if (!free_.empty()) {
+            node = nodeFrom(free_.next);
+            node->lru.remove();
+            ++size_;
+        } else {
+            // Reclaim the coldest entry: the tail of the recency list.
+            node = nodeFrom(recency_.prev);
+            node->lru.remove();
+            table_.remove(node->key);
+        }
+        node->key = key;
+        node->value = value;
+        node->lru.add(&recency_);
+        table_.insert(key, node);
+    }
+
+    // Drop `key` if present; its node returns to the free pool.
+    bool erase(const KeyType& key) {
+        auto found = table_.find(key);
+        if (!found.has_value()) {
+            return false;
+        }
+        Node* node = *found;
+        table_.remove(key);
+        node->lru.remove();
+        node->lru.add(&free_);
+        --size_;
+        return true;
+    }
+
+    bool contains(const KeyType& key) const { return table_.find(key).has_value(); }
+
+private:
+    struct Node {
+        ListHead lru; // Links into recency_ when live, free_ when pooled
+        KeyType key;
+        ValueType value;
+    };
+
+    static Node* nodeFrom(ListHead* head) {
+        return reinterpret_cast<Node*>(reinterpret_cast<char*>(head) - offsetof(Node, lru));
+    }
+
+    void touch(Node* node) {
+        node->lru.remove();
+        node->lru.add(&recency_); // Front = most recently used
+    }
+
+    const size_t capacity_;
+    size_t size_ = 0;
+    std::vector<Node> nodes_;
+    ListHead recency_; // Head = hottest, tail = eviction candidate
+    ListHead free_;
+    HashTable<KeyType, Node*, Hash> table_;
+};
@@ -0,0 +1,193 @@
+#include <x86intrin.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// One microbenchmark harness for the timing loops scattered around the repo
+// (visit_vs_virtual's benchmark() template, the raw throughput prints in
+// queue/). Register a function with MICROBENCHMARK and runAll() handles what
+// the ad-hoc loops skip: iteration counts calibrated so each sample runs
+// long enough to measure, discarded warmup samples, median-of-N with MAD
+// outlier rejection so one scheduler hiccup can't shift the result, cycles
+// via rdtscp next to wall time, and JSON output that diffs cleanly
+// run-to-run.
+
+// Keep a value alive without emitting any code for it, so the optimizer
+// can't delete the measured work.
+template <typename T>
+inline void doNotOptimize(T const& value) {
+    asm volatile("" : : "g"(value) : "memory");
+}
+
+inline double sampleMedian(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    const size_t n = values.size();
+    return n % 2 == 1 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2.0;
+}
+
+// Median absolute deviation: a spread estimate a few wild samples cannot
+// drag around, unlike the standard deviation.
+inline double sampleMad(const std::vector<double>& values, double median) {
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (double value : values) {
+        deviations.push_back(std::fabs(value - median));
+    }
+    return sampleMedian(std::move(deviations));
+}
+
+// Drop samples more than `k` scaled MADs from the median (1.4826 * MAD
+// estimates one standard deviation for normal data). With MAD zero the
+// samples are essentially identical and nothing is rejected.
+inline std::vector<double> rejectOutliers(const std::vector<double>& values, double k = 3.0) {
+    const double median = sampleMedian(values);
+    const double spread = 1.4826 * sampleMad(values, median);
+    if (spread == 0.0) {
+        return values;
+    }
+    std::vector<double> kept;
+    kept.reserve(values.size());
+    for (double value : values) {
+        if (std::fabs(value - median) <= k * spread) {
+            kept.push_back(value);
+        }
+    }
+    return kept;
+}
+
+struct BenchResult {
+    std::string name;
+    size_t iterations = 0;   // Per sample, after calibration
+    double ns_per_op = 0.0;  // Median over kept samples
+    double mad_ns = 0.0;     // Spread of the kept samples
+    double cycles_per_op = 0.0;
+    int samples_kept = 0;
+    int samples_rejected = 0;
+};
+
+// Registry of benchmark functions. A benchmark receives the iteration count
+// and must run its operation exactly that many times; setup it does once
+// (building inputs, etc.) should live in function-local statics so only the
+// loop is timed.
+class BenchmarkRegistry {
+public:
+    using BenchFn = void (*)(size_t iterations);
+
+    static constexpr size_t kSamples = 15;
+    static constexpr size_t kWarmupSamples = 3;
+    static constexpr uint64_t kMinSampleNs = 2'000'000; // 2ms per sample
+
+    static BenchmarkRegistry& instance() {
+        static BenchmarkRegistry registry;
+        return registry;
+    }
+
+    bool add(std::string name, BenchFn fn) {
+        entries_.push_back({std::move(name), fn});
+        return true;
+    }
+
+    BenchResult run(const std::string& name, BenchFn fn) const {
+        // Calibrate: double the iteration count until one sample runs long
+        // enough that clock granularity and loop overhead are noise.
+        size_t iterations = 1;
+        while (timeSample(fn, iterations).wall_ns < kMinSampleNs) {
+            iterations *= 2;
+        }
+
+        for (size_t i = 0; i < kWarmupSamples; ++i) {
+            timeSample(fn, iterations); // Discarded: caches, predictor, frequency
+        }
+
+        std::vector<double> ns_per_op;
+        std::vector<double> cycles_per_op;
+        for (size_t i = 0; i < kSamples; ++i) {
+            const Sample sample = timeSample(fn, iterations);
+            ns_per_op.push_back(static_cast<double>(sample.wall_ns) / iterations);
+            cycles_per_op.push_back(static_cast<double>(sample.cycles) / iterations);
+        }
+
+        const std::vector<double> kept = rejectOutliers(ns_per_op);
+        BenchResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.ns_per_op = sampleMedian(kept);
+        result.mad_ns = sampleMad(kept, result.ns_per_op);
+        result.cycles_per_op = sampleMedian(cycles_per_op);
+        result.samples_kept = static_cast<int>(kept.size());
+        result.samples_rejected = static_cast<int>(ns_per_op.size() - kept.size());
+        return result;
+    }
+
+    // Run every registered benchmark, printing one human-readable line per
+    // result to `out` as it lands.
+    std::vector<BenchResult> runAll(std::ostream& out) const {
+        std::vector<BenchResult> results;
+        for (const Entry& entry : entries_) {
+            results.push_back(run(entry.name, entry.fn));
+            const BenchResult& r = results.back();
+            out << r.name << ": " << r.ns_per_op << " ns/op (" << r.cycles_per_op
+                << " cycles/op, mad " << r.mad_ns << " ns, " << r.samples_kept
+                << " samples";
+            if (r.samples_rejected > 0) {
+                out << ", " << r.samples_rejected << " rejected";
+            }
+            out << ")\n";
+        }
+        return results;
+    }
+
+    // Emit results as a JSON array, one object per benchmark, for gating
+    // scripts that diff runs.
+    static void writeJson(const std::vector<BenchResult>& results, std::ostream& out) {
+        out << "[\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            out << "  {\"name\": \"" << r.name << "\""
+                << ", \"iterations\": " << r.iterations
+                << ", \"ns_per_op\": " << r.ns_per_op
+                << ", \"mad_ns\": " << r.mad_ns
+                << ", \"cycles_per_op\": " << r.cycles_per_op
+                << ", \"samples_kept\": " << r.samples_kept
+                << ", \"samples_rejected\": " << r.samples_rejected << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+
+    size_t size() const { return entries_.size(); }
+
+private:
+    struct Entry {
+        std::string name;
+        BenchFn fn;
+    };
+
+    struct Sample {
+        uint64_t wall_ns;
+        uint64_t cycles;
+    };
+
+    static Sample timeSample(BenchFn fn, size_t iterations) {
+        unsigned aux;
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t start_cycles = __rdtscp(&aux);
+        fn(iterations);
+        const uint64_t end_cycles = __rdtscp(&aux);
+        const auto end = std::chrono::steady_clock::now();
+        return {static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()),
+                end_cycles - start_cycles};
+    }
+
+    std::vector<Entry> entries_;
+};
+
+// Register `fn` (void(size_t iterations)) under its own name.
+#define MICROBENCHMARK(fn) \
+    static const bool fn##_registered_ = BenchmarkRegistry::instance().add(#fn, fn)
@@ -7,16 +7,9 @@
 #include <thread>
 #include <sched.h>
 
-constexpr double CPU_FREQUENCY_GHZ = 2.495947; // Initial CPU frequency in GHz
+#include "cpu_topology.cpp"
 
-void set_cpu_affinity(int core_id) {
-    cpu_set_t cpuset;
-    CPU_ZERO(&cpuset);
-    CPU_SET(core_id, &cpuset);
-    if (sched_setaffinity(0, sizeof(cpu_set_t), &cpuset) != 0) {
-        std::cerr << "Failed to set CPU affinity. Measurements may be less accurate.\n";
-    }
-}
+constexpr double CPU_FREQUENCY_GHZ = 2.495947; // Initial CPU frequency in GHz
 
 void tick_every(int milli, int num_ticks) {
     double tick_time = milli / 1000.0;
@@ -78,7 +71,9 @@ void tick_every(int milli, int num_ticks) {
 
 int main() {
     // Bind the process to a single core to minimize context switching
-    set_cpu_affinity(0);
+    if (!pin_current_thread(0)) {
+        std::cerr << "Failed to set CPU affinity. Measurements may be less accurate.\n";
+    }
 
     // Run the tick function
     tick_every(10, 5000);
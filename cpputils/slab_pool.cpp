@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "wub_shared_ptr.cpp"
+
+// Fixed-size slab pool for hot-path message objects. Every slot is one
+// cache line carrying the object, its SharedPtr refcount and its free-list
+// link, allocated in a single block at construction — so at steady state a
+// makeShared/drop cycle never touches the global allocator (the default
+// SharedPtr path costs a new T plus a new refcount per message). Threads
+// allocate from a private cache and exchange slots with the shared free
+// list in batches, so neither the malloc lock nor a pool mutex shows up
+// per message.
+template<typename T>
+class SlabPool {
+public:
+    static constexpr size_t kRefillBatch = 32;
+
+    explicit SlabPool(size_t capacity) : slots_(capacity) {
+        free_.reserve(capacity);
+        for (Slot& slot : slots_) {
+            slot.pool = this;
+            free_.push_back(&slot);
+        }
+    }
+
+    // Construct a T in a pooled slot and wrap it in a SharedPtr whose
+    // deleter recycles the slot. Returns an empty SharedPtr when the pool
+    // (and the calling thread's cache) is exhausted.
+    template<typename... Args>
+    SharedPtr<T> makeShared(Args&&... args) {
+        Slot* slot = acquireSlot();
+        if (slot == nullptr) {
+            return SharedPtr<T>();
+        }
+        T* object = new (slot->storage) T(std::forward<Args>(args)...);
+        return SharedPtr<T>(object, &slot->ref_count, &SlabPool::recycle);
+    }
+
+    size_t capacity() const { return slots_.size(); }
+
+    // Slots currently handed out (global view; slots parked in thread
+    // caches count as free).
+    size_t outstanding() const {
+        std::lock_guard<std::mutex> lock(freeMutex_);
+        return slots_.size() - free_.size() -
+               cached_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<int> ref_count{0};
+        SlabPool* pool;
+        Slot* next; // Unused; keeps the hot fields off the storage line
+        alignas(alignof(T)) unsigned char storage[sizeof(T)];
+    };
+    static_assert(alignof(T) <= 64, "Slot storage is cache-line aligned");
+
+    // Deleter installed into every pooled SharedPtr: destroy the object and
+    // hand its slot back to the owning pool.
+    static void recycle(T* object) {
+        Slot* slot = slotOf(object);
+        object->~T();
+        slot->pool->releaseSlot(slot);
+    }
+
+    static Slot* slotOf(T* object) {
+        return reinterpret_cast<Slot*>(reinterpret_cast<char*>(object) -
+                                       offsetof(Slot, storage));
+    }
+
+    // Per-thread slot cache. Keyed by a unique pool id rather than `this`
+    // so a pool reallocated at a dead pool's address can never pick up its
+    // stale cached slots; entries for dead pools just sit unmatched.
+    std::vector<Slot*>& threadCache() {
+        thread_local std::vector<std::pair<uint64_t, std::vector<Slot*>>> caches;
+        for (auto& [id, cache] : caches) {
+            if (id == id_) {
+                return cache;
+            }
+        }
+        caches.emplace_back(id_, std::vector<Slot*>{});
+        caches.back().second.reserve(2 * kRefillBatch); // Never grows past this
+        return caches.back().second;
+    }
+
+    static uint64_t nextPoolId() {
+        static std::atomic<uint64_t> next{0};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Slot* acquireSlot() {
+        std::vector<Slot*>& cache = threadCache();
+        if (cache.empty()) {
+            std::lock_guard<std::mutex> lock(freeMutex_);
+            const size_t take = std::min(kRefillBatch, free_.size());
+            if (take == 0) {
+                return nullptr;
+            }
+            cache.insert(cache.end(), free_.end() - take, free_.end());
+            free_.resize(free_.size() - take);
+            cached_.fetch_add(take, std::memory_order_relaxed);
+        }
+        Slot* slot = cache.back();
+        cache.pop_back();
+        cached_.fetch_sub(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    void releaseSlot(Slot* slot) {
+        std::vector<Slot*>& cache = threadCache();
+        cache.push_back(slot);
+        cached_.fetch_add(1, std::memory_order_relaxed);
+        if (cache.size() >= 2 * kRefillBatch) {
+            // Flush half back so bursty threads don't hoard the pool.
+            std::lock_guard<std::mutex> lock(freeMutex_);
+            free_.insert(free_.end(), cache.end() - kRefillBatch, cache.end());
+            cache.resize(cache.size() - kRefillBatch);
+            cached_.fetch_sub(kRefillBatch, std::memory_order_relaxed);
+        }
+    }
+
+    const uint64_t id_ = nextPoolId();
+    std::vector<Slot> slots_;
+    mutable std::mutex freeMutex_;
+    std::vector<Slot*> free_;
+    std::atomic<size_t> cached_{0}; // Slots parked in thread caches
+};
@@ -0,0 +1,265 @@
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+// Structured binary logging: instead of formatting text that downstream
+// analytics re-tokenize, the sink writes raw records — (format-string ID,
+// timestamp, packed args) — and a sidecar file mapping each ID back to its
+// format string and argument types. The ID is a constexpr FNV-1a hash of the
+// format string, computed at compile time by the STRUCTURED_LOG macro, so the
+// hot path never touches the string at all and its cost is independent of
+// message length. An offline decoder (see the bottom of this file) joins the
+// record stream against the sidecar and reproduces the formatted text.
+//
+// This complements async_binary_log.cpp: that file defers formatting to a
+// drainer thread but still emits text; this one keeps the log binary all the
+// way to disk, cutting volume to ~24 bytes + 8 per argument per record.
+
+constexpr uint64_t kFnvOffsetBasis = 1469598103934665603ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+constexpr uint64_t fnv1aHash(const char* s) {
+    uint64_t hash = kFnvOffsetBasis;
+    for (; *s; ++s) {
+        hash ^= static_cast<uint8_t>(*s);
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+static_assert(fnv1aHash("") == kFnvOffsetBasis);
+static_assert(fnv1aHash("a") != fnv1aHash("b"));
+
+// On-disk record header, followed by arg_count raw 64-bit argument slots.
+struct StructuredRecordHeader {
+    static constexpr size_t kMaxArgs = 4;
+
+    uint64_t site_hash;    // constexpr hash of the format string
+    uint64_t timestamp_ns;
+    uint32_t arg_count;
+    uint32_t reserved;     // keeps the header at 24 bytes, no implicit padding
+};
+static_assert(sizeof(StructuredRecordHeader) == 24);
+
+// Single-character type tags recorded in the sidecar so the decoder knows how
+// to render each raw slot: 'i' signed integer, 'u' unsigned integer / bool,
+// 'f' floating point.
+template<typename T>
+constexpr char typeTagFor() {
+    using D = std::decay_t<T>;
+    static_assert(!std::is_pointer_v<D>,
+                  "string arguments do not survive offline decoding; the "
+                  "structured sink carries arithmetic arguments only");
+    if constexpr (std::is_floating_point_v<D>) {
+        return 'f';
+    } else if constexpr (std::is_enum_v<D> || std::is_signed_v<D>) {
+        return 'i';
+    } else {
+        static_assert(std::is_integral_v<D>,
+                      "only integral, enum, and floating args are loggable");
+        return 'u';
+    }
+}
+
+class StructuredBinaryLog {
+public:
+    StructuredBinaryLog(const std::string& data_path, const std::string& sidecar_path)
+        : data_(data_path, std::ios::binary | std::ios::trunc),
+          sidecar_(sidecar_path, std::ios::trunc) {}
+
+    ~StructuredBinaryLog() { flush(); }
+
+    // One-time per call site: append "<hash>\t<type-tags>\t<fmt>" to the
+    // sidecar. The hash was computed at compile time by the macro; the args
+    // are only used to deduce the type tags. Flushed immediately so the
+    // sidecar is complete even if the process dies mid-run.
+    template<typename... Args>
+    bool registerSite(uint64_t hash, const char* fmt, const Args&...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!registered_.insert(hash).second) {
+            return true; // Same format string logged from another site
+        }
+        char tags[StructuredRecordHeader::kMaxArgs + 1] = {};
+        size_t slot = 0;
+        ((tags[slot++] = typeTagFor<Args>()), ...);
+        sidecar_ << std::hex << hash << std::dec << '\t' << tags << '\t' << fmt << '\n';
+        sidecar_.flush();
+        return true;
+    }
+
+    // Hot path: a fixed-size header plus one 64-bit slot per argument. No
+    // format parsing, no allocation — the same bytes hit the (buffered)
+    // stream whether the format string is 10 characters or 200.
+    template<typename... Args>
+    void log(uint64_t hash, const Args&... args) {
+        static_assert(sizeof...(Args) <= StructuredRecordHeader::kMaxArgs,
+                      "structured log records carry at most 4 arguments");
+        StructuredRecordHeader header;
+        header.site_hash = hash;
+        header.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        header.arg_count = sizeof...(Args);
+        header.reserved = 0;
+        uint64_t slots[StructuredRecordHeader::kMaxArgs] = {};
+        size_t slot = 0;
+        ((slots[slot++] = encode(args)), ...);
+        std::lock_guard<std::mutex> lock(mutex_);
+        data_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        data_.write(reinterpret_cast<const char*>(slots),
+                    static_cast<std::streamsize>(header.arg_count * sizeof(uint64_t)));
+    }
+
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        data_.flush();
+        sidecar_.flush();
+    }
+
+private:
+    // Same slot encoding as async_binary_log.cpp: integers widen, doubles
+    // are bit-cast. Pointers are rejected at compile time by typeTagFor().
+    template<typename T>
+    static uint64_t encode(const T& value) {
+        using D = std::decay_t<T>;
+        if constexpr (std::is_floating_point_v<D>) {
+            return std::bit_cast<uint64_t>(static_cast<double>(value));
+        } else {
+            return static_cast<uint64_t>(value);
+        }
+    }
+
+    std::ofstream data_;
+    std::ofstream sidecar_;
+    std::mutex mutex_;
+    std::unordered_set<uint64_t> registered_;
+};
+
+// Call-site macro: the format string hashes at compile time, the sidecar
+// entry is written on first execution, and every pass after that is just the
+// binary record push.
+//
+//     STRUCTURED_LOG(blog, "fill {} @ {}", order_id, price);
+#define STRUCTURED_LOG(blogger, fmtstr, ...)                                         \
+    do {                                                                             \
+        constexpr uint64_t _slog_hash = fnv1aHash(fmtstr);                           \
+        static const bool _slog_registered =                                         \
+            (blogger).registerSite(_slog_hash, fmtstr __VA_OPT__(, ) __VA_ARGS__);   \
+        (void)_slog_registered;                                                      \
+        (blogger).log(_slog_hash __VA_OPT__(, ) __VA_ARGS__);                        \
+    } while (0)
+
+// ---------------------------------------------------------------------------
+// Offline decoder: joins a record stream against its sidecar and writes one
+// "[timestamp_ns] formatted text" line per record. Deliberately free of any
+// fmt/spdlog dependency so the tool builds standalone:
+//
+//     g++ -std=c++20 -O2 -DSTRUCTURED_LOG_DECODER_MAIN \
+//         structured_binary_log.cpp -o slog_decode
+//     ./slog_decode trades.slog trades.sidecar
+
+struct DecodedSite {
+    std::string tags;
+    std::string fmt;
+};
+
+inline std::string renderStructuredRecord(const DecodedSite& site,
+                                          const StructuredRecordHeader& header,
+                                          const uint64_t* slots) {
+    std::string text;
+    text.reserve(site.fmt.size() + header.arg_count * 8);
+    size_t next = 0;
+    for (const char* p = site.fmt.c_str(); *p; ++p) {
+        if (p[0] == '{' && p[1] == '}' && next < header.arg_count &&
+            next < site.tags.size()) {
+            char buf[32];
+            switch (site.tags[next]) {
+            case 'f':
+                std::snprintf(buf, sizeof(buf), "%g", std::bit_cast<double>(slots[next]));
+                break;
+            case 'i':
+                std::snprintf(buf, sizeof(buf), "%lld",
+                              static_cast<long long>(slots[next]));
+                break;
+            default: // 'u'
+                std::snprintf(buf, sizeof(buf), "%llu",
+                              static_cast<unsigned long long>(slots[next]));
+                break;
+            }
+            text += buf;
+            ++p; // Skip the '}'
+            ++next;
+        } else {
+            text += *p;
+        }
+    }
+    return text;
+}
+
+inline bool decodeStructuredLog(const std::string& data_path,
+                                const std::string& sidecar_path,
+                                std::ostream& out) {
+    std::ifstream sidecar(sidecar_path);
+    if (!sidecar) {
+        return false;
+    }
+    std::unordered_map<uint64_t, DecodedSite> sites;
+    std::string line;
+    while (std::getline(sidecar, line)) {
+        const size_t tab1 = line.find('\t');
+        const size_t tab2 = line.find('\t', tab1 + 1);
+        if (tab1 == std::string::npos || tab2 == std::string::npos) {
+            continue;
+        }
+        const uint64_t hash = std::stoull(line.substr(0, tab1), nullptr, 16);
+        sites[hash] = {line.substr(tab1 + 1, tab2 - tab1 - 1), line.substr(tab2 + 1)};
+    }
+
+    std::ifstream data(data_path, std::ios::binary);
+    if (!data) {
+        return false;
+    }
+    StructuredRecordHeader header;
+    while (data.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        if (header.arg_count > StructuredRecordHeader::kMaxArgs) {
+            return false; // Corrupt stream
+        }
+        uint64_t slots[StructuredRecordHeader::kMaxArgs] = {};
+        if (header.arg_count > 0 &&
+            !data.read(reinterpret_cast<char*>(slots),
+                       static_cast<std::streamsize>(header.arg_count * sizeof(uint64_t)))) {
+            return false; // Truncated record
+        }
+        const auto it = sites.find(header.site_hash);
+        out << '[' << header.timestamp_ns << "] ";
+        if (it == sites.end()) {
+            out << "<unknown site " << std::hex << header.site_hash << std::dec << ">\n";
+        } else {
+            out << renderStructuredRecord(it->second, header, slots) << '\n';
+        }
+    }
+    return true;
+}
+
+#ifdef STRUCTURED_LOG_DECODER_MAIN
+#include <iostream>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <data-file> <sidecar-file>\n";
+        return 1;
+    }
+    if (!decodeStructuredLog(argv[1], argv[2], std::cout)) {
+        std::cerr << "decode failed\n";
+        return 1;
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <sstream>
+#include <thread>
+#include "../cpu_topology.cpp"
+
+TEST(CpuTopologyTest, EnumeratesEveryCpuWithAValidNode) {
+    CpuTopology topology;
+    ASSERT_GE(topology.cpus().size(), 1u);
+    ASSERT_GE(topology.numNodes(), 1);
+    for (const CpuTopology::Cpu& cpu : topology.cpus()) {
+        EXPECT_GE(cpu.node, 0);
+        EXPECT_LT(cpu.node, topology.numNodes());
+    }
+}
+
+TEST(CpuTopologyTest, EveryCpuAppearsOnExactlyOneNode) {
+    CpuTopology topology;
+    size_t total = 0;
+    for (int node = 0; node < topology.numNodes(); ++node) {
+        total += topology.cpusOnNode(node).size();
+    }
+    EXPECT_EQ(total, topology.cpus().size());
+}
+
+TEST(CpuTopologyTest, PinCurrentThreadLandsOnRequestedCpu) {
+    CpuTopology topology;
+    const int target = topology.cpus().back().id;
+    ASSERT_TRUE(pin_current_thread(target));
+    EXPECT_EQ(sched_getcpu(), target);
+
+    // Restore the full mask so later tests are free to migrate.
+    cpu_set_t all;
+    CPU_ZERO(&all);
+    for (const CpuTopology::Cpu& cpu : topology.cpus()) {
+        CPU_SET(cpu.id, &all);
+    }
+    sched_setaffinity(0, sizeof(all), &all);
+}
+
+TEST(NumaArrayTest, AllocatesConstructsAndStoresValues) {
+    NumaArray<int> values(1024, 0);
+    ASSERT_EQ(values.size(), 1024u);
+    EXPECT_EQ(values.node(), 0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], 0); // Value-initialized
+        values[i] = static_cast<int>(i);
+    }
+    EXPECT_EQ(values[1023], 1023);
+}
+
+TEST(PlacementSpecTest, ResolvesRolesToCpus) {
+    PlacementSpec spec;
+    spec.place("producer", 0);
+    spec.place("consumer-0", 0);
+    EXPECT_EQ(spec.cpuFor("producer"), 0);
+    EXPECT_EQ(spec.cpuFor("no-such-role"), -1);
+    EXPECT_FALSE(spec.pinCurrentThread("no-such-role"));
+}
+
+TEST(PlacementSpecTest, ReportsRolesCrossNodeFromStorage) {
+    PlacementSpec spec;
+    spec.place("producer", 0);
+    spec.place("consumer-0", 0);
+
+    std::ostringstream report;
+    const int local_node = CpuTopology::nodeOf(0);
+    EXPECT_EQ(spec.reportCrossNode(local_node, report), 0);
+
+    // Pretend the storage sits on a node no cpu belongs to: every role is
+    // then a crosser, regardless of the machine we run on.
+    std::ostringstream cross_report;
+    CpuTopology topology;
+    EXPECT_EQ(spec.reportCrossNode(topology.numNodes(), cross_report), 2);
+    EXPECT_NE(cross_report.str().find("[cross-node"), std::string::npos);
+}
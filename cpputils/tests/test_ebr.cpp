@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../ebr.cpp"
+
+namespace {
+
+std::atomic<int> g_deleted{0};
+
+struct Tracked {
+    int value;
+    explicit Tracked(int v) : value(v) {}
+    ~Tracked() { g_deleted.fetch_add(1, std::memory_order_relaxed); }
+};
+
+// Drive epoch advances until the domain's limbo lists drain.
+void reclaimAll() {
+    for (int i = 0; i < 10 && EbrDomain::instance().pending() > 0; ++i) {
+        EbrDomain::instance().tryReclaim();
+    }
+}
+
+} // namespace
+
+TEST(EbrTest, RetiredObjectsAreFreedOnceEpochsAdvance) {
+    g_deleted = 0;
+    for (int i = 0; i < 5; ++i) {
+        EbrDomain::instance().retire(new Tracked(i));
+    }
+    reclaimAll();
+    EXPECT_EQ(g_deleted.load(), 5);
+    EXPECT_EQ(EbrDomain::instance().pending(), 0u);
+}
+
+TEST(EbrTest, PinnedGuardBlocksReclamation) {
+    g_deleted = 0;
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+
+    // The guard must live on another thread: tryReclaim() on this thread
+    // would see its own pinned slot either way.
+    std::thread reader([&] {
+        EbrGuard guard;
+        pinned = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned) {
+        std::this_thread::yield();
+    }
+
+    // One advance may succeed (the reader observed the current epoch), but
+    // the reader then lags behind and pins every further advance, so the
+    // object retired now can never complete the two advances it needs.
+    EbrDomain::instance().retire(new Tracked(42));
+    for (int i = 0; i < 10; ++i) {
+        EbrDomain::instance().tryReclaim();
+    }
+    EXPECT_EQ(g_deleted.load(), 0);
+
+    release = true;
+    reader.join();
+    reclaimAll();
+    EXPECT_EQ(g_deleted.load(), 1);
+}
+
+TEST(EbrTest, ReadersNeverObserveReclaimedObjects) {
+    g_deleted = 0;
+    constexpr int kUpdates = 20000;
+    constexpr int kReaders = 4;
+
+    std::atomic<Tracked*> shared{new Tracked(0)};
+    std::atomic<bool> done{false};
+    std::atomic<int> bad_reads{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < kReaders; ++i) {
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                EbrGuard guard;
+                Tracked* current = shared.load(std::memory_order_acquire);
+                if (current->value < 0 || current->value > kUpdates) {
+                    bad_reads.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= kUpdates; ++i) {
+        Tracked* old = shared.exchange(new Tracked(i), std::memory_order_acq_rel);
+        EbrDomain::instance().retire(old);
+        if ((i & 127) == 0) {
+            EbrDomain::instance().tryReclaim();
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(bad_reads.load(), 0);
+    delete shared.load();
+    reclaimAll();
+    EXPECT_EQ(g_deleted.load(), kUpdates + 1); // Retired ones plus the survivor
+}
+
+TEST(EbrTest, RetireWithCustomDeleter) {
+    int freed = 0;
+    static int* s_freed;
+    s_freed = &freed;
+    int payload = 7;
+    EbrDomain::instance().retire(&payload, [](void*) { ++*s_freed; });
+    reclaimAll();
+    EXPECT_EQ(freed, 1);
+}
@@ -105,3 +105,80 @@ TEST_F(ListHeadTest, FromListHeadUtility) {
     ListEntry<int> *entry = ListEntry<int>::from_list_head(head.next);
     EXPECT_EQ(entry->data, 1);
 }
+
+// Test splicing a whole chain between lists in O(1)
+TEST_F(ListHeadTest, SpliceMovesChain) {
+    ListHead other;
+    item1.list.add_tail(&other);
+    item2.list.add_tail(&other);
+    item3.list.add_tail(&other);
+
+    head.splice(other.next, other.prev); // Move all three
+    EXPECT_TRUE(other.empty());
+
+    ListHead *pos = head.next;
+    int expected_data[] = {1, 2, 3};
+    int index = 0;
+    while (pos != &head) {
+        EXPECT_EQ(ListEntry<int>::from_list_head(pos)->data, expected_data[index++]);
+        pos = pos->next;
+    }
+    EXPECT_EQ(index, 3);
+}
+
+// Test splicing a partial chain leaves the remainder intact
+TEST_F(ListHeadTest, SplicePartialChain) {
+    ListHead other;
+    item1.list.add_tail(&other);
+    item2.list.add_tail(&other);
+    item3.list.add_tail(&other);
+
+    head.splice(&item1.list, &item2.list); // Move [1, 2], leave 3
+
+    EXPECT_EQ(other.next, &item3.list);
+    EXPECT_EQ(other.prev, &item3.list);
+    EXPECT_EQ(head.next, &item1.list);
+    EXPECT_EQ(head.next->next, &item2.list);
+    EXPECT_EQ(head.prev, &item2.list);
+}
+
+// Test splice_all on an empty source is a no-op
+TEST_F(ListHeadTest, SpliceAllEmptySource) {
+    ListHead other;
+    item1.list.add(&head);
+    head.splice_all(&other);
+
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(head.next, &item1.list);
+    EXPECT_EQ(head.prev, &item1.list);
+}
+
+// Test the prefetching iteration helper visits every node in order
+TEST_F(ListHeadTest, ForEachPrefetchVisitsInOrder) {
+    item1.list.add_tail(&head);
+    item2.list.add_tail(&head);
+    item3.list.add_tail(&head);
+
+    std::vector<int> seen;
+    for_each_prefetch(&head, [&seen](ListHead *pos) {
+        seen.push_back(ListEntry<int>::from_list_head(pos)->data);
+    });
+    EXPECT_EQ(seen, (std::vector<int>{1, 2, 3}));
+}
+
+// Test that the visitor may remove nodes during traversal
+TEST_F(ListHeadTest, ForEachPrefetchAllowsRemoval) {
+    item1.list.add_tail(&head);
+    item2.list.add_tail(&head);
+    item3.list.add_tail(&head);
+
+    for_each_prefetch(&head, [](ListHead *pos) {
+        if (ListEntry<int>::from_list_head(pos)->data == 2) {
+            pos->remove();
+        }
+    });
+
+    EXPECT_EQ(head.next, &item1.list);
+    EXPECT_EQ(head.next->next, &item3.list);
+    EXPECT_EQ(head.prev, &item3.list);
+}
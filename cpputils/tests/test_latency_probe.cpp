@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <spdlog/sinks/null_sink.h>
+#include "../latency_probe.cpp"
+
+TEST(LatencyHistogramTest, ExactBucketsBelowOneOctave) {
+    for (uint64_t v = 0; v < LatencyHistogram::kSubBuckets; ++v) {
+        EXPECT_EQ(LatencyHistogram::bucketIndex(v), static_cast<int>(v));
+        EXPECT_EQ(LatencyHistogram::bucketValue(static_cast<int>(v)), v);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketValueBracketsInput) {
+    // Above the exact range the bucket midpoint must stay within the
+    // log-linear resolution (one part in kSubBuckets) of the sample.
+    for (uint64_t v = 32; v < (1ull << 40); v = v * 3 + 7) {
+        const int idx = LatencyHistogram::bucketIndex(v);
+        const uint64_t mid = LatencyHistogram::bucketValue(idx);
+        const double rel = std::abs(static_cast<double>(mid) - static_cast<double>(v)) / v;
+        EXPECT_LT(rel, 1.0 / LatencyHistogram::kSubBuckets) << "value " << v;
+    }
+}
+
+TEST(LatencyHistogramTest, TopOctaveStaysInBounds) {
+    // A wrapped negative delta recorded as uint64 lands in the top octave
+    // (msb 63); its index must stay inside counts_. Regression test: this
+    // used to compute indices past kBucketCount.
+    const uint64_t topValues[] = {1ull << 63, UINT64_MAX - 1, UINT64_MAX};
+    for (uint64_t v : topValues) {
+        const int idx = LatencyHistogram::bucketIndex(v);
+        EXPECT_GE(idx, 0) << "value " << v;
+        EXPECT_LT(idx, LatencyHistogram::kBucketCount) << "value " << v;
+    }
+    LatencyHistogram hist;
+    hist.record(UINT64_MAX); // Must not write out of bounds
+    EXPECT_EQ(hist.total(), 1u);
+}
+
+TEST(LatencyHistogramTest, DrainMovesCountsAndResets) {
+    LatencyHistogram hist;
+    for (int i = 0; i < 1000; ++i) {
+        hist.record(100);
+    }
+    EXPECT_EQ(hist.total(), 1000u);
+
+    std::array<uint64_t, LatencyHistogram::kBucketCount> sums{};
+    EXPECT_EQ(hist.drainInto(sums), 1000u);
+    EXPECT_EQ(hist.total(), 0u);
+    EXPECT_EQ(sums[LatencyHistogram::bucketIndex(100)], 1000u);
+}
+
+TEST(LatencyProbeTest, ScopedProbeRecordsAcrossThreads) {
+    auto logger = std::make_shared<spdlog::logger>(
+        "probe_test", std::make_shared<spdlog::sinks::null_sink_mt>());
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([] {
+            for (int i = 0; i < 10000; ++i) {
+                LATENCY_PROBE("test_site");
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    // report() drains everything it aggregated; a second report sees nothing.
+    ProbeRegistry::instance().report(*logger);
+    ProbeRegistry::instance().report(*logger);
+}
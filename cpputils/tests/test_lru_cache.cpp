@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../lru_cache.cpp"
+
+TEST(LruCacheTest, BasicPutAndGet) {
+    LruCache<int, std::string> cache(3);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    EXPECT_EQ(cache.get(1), "one");
+    EXPECT_EQ(cache.get(2), "two");
+    EXPECT_FALSE(cache.get(3).has_value());
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed) {
+    LruCache<int, int> cache(3);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    cache.get(1);    // 1 is now hottest; 2 is coldest
+    cache.put(4, 40); // Evicts 2
+
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_EQ(cache.get(1), 10);
+    EXPECT_EQ(cache.get(3), 30);
+    EXPECT_EQ(cache.get(4), 40);
+    EXPECT_EQ(cache.size(), 3u);
+}
+
+TEST(LruCacheTest, PutUpdatesAndTouches) {
+    LruCache<int, int> cache(2);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(1, 11); // Update refreshes recency too
+    cache.put(3, 30); // Evicts 2, not 1
+
+    EXPECT_EQ(cache.get(1), 11);
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_EQ(cache.get(3), 30);
+}
+
+TEST(LruCacheTest, EraseReturnsNodeToPool) {
+    LruCache<int, int> cache(2);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    EXPECT_TRUE(cache.erase(1));
+    EXPECT_FALSE(cache.erase(1));
+    EXPECT_EQ(cache.size(), 1u);
+
+    // The freed node is reusable without evicting the survivor.
+    cache.put(3, 30);
+    EXPECT_TRUE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(3));
+}
+
+TEST(LruCacheTest, ChurnWellPastCapacity) {
+    LruCache<int, int> cache(16);
+    for (int i = 0; i < 10000; ++i) {
+        cache.put(i, i * 2);
+    }
+    EXPECT_EQ(cache.size(), 16u);
+    // Exactly the last 16 inserts survive.
+    for (int i = 10000 - 16; i < 10000; ++i) {
+        EXPECT_EQ(cache.get(i), i * 2);
+    }
+    EXPECT_FALSE(cache.contains(10000 - 17));
+}
+
+TEST(LruCacheTest, ZeroCapacityThrows) {
+    EXPECT_THROW((LruCache<int, int>(0)), std::invalid_argument);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <sstream>
+#include "../microbench.cpp"
+
+TEST(MicrobenchStatsTest, MedianOfOddAndEvenCounts) {
+    EXPECT_DOUBLE_EQ(sampleMedian({3.0, 1.0, 2.0}), 2.0);
+    EXPECT_DOUBLE_EQ(sampleMedian({4.0, 1.0, 2.0, 3.0}), 2.5);
+}
+
+TEST(MicrobenchStatsTest, MadIsRobustToOneWildSample) {
+    const std::vector<double> samples{10.0, 10.0, 11.0, 9.0, 10.0, 500.0};
+    const double median = sampleMedian(samples);
+    EXPECT_DOUBLE_EQ(median, 10.0);
+    // The 500 barely moves the MAD, where it would dominate a stddev.
+    EXPECT_LE(sampleMad(samples, median), 1.0);
+}
+
+TEST(MicrobenchStatsTest, RejectOutliersDropsOnlyTheWildSamples) {
+    const std::vector<double> samples{10.0, 10.5, 9.5, 10.0, 11.0, 9.0, 500.0};
+    const std::vector<double> kept = rejectOutliers(samples);
+    EXPECT_EQ(kept.size(), samples.size() - 1);
+    for (double value : kept) {
+        EXPECT_LT(value, 100.0);
+    }
+}
+
+TEST(MicrobenchStatsTest, IdenticalSamplesAreAllKept) {
+    const std::vector<double> samples(10, 42.0);
+    EXPECT_EQ(rejectOutliers(samples).size(), samples.size());
+}
+
+namespace {
+std::atomic<uint64_t> g_op_count{0};
+
+void countingBenchmark(size_t iterations) {
+    for (size_t i = 0; i < iterations; ++i) {
+        g_op_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+} // namespace
+
+TEST(BenchmarkRegistryTest, RunCalibratesWarmsUpAndMeasures) {
+    g_op_count = 0;
+    BenchmarkRegistry registry;
+    const BenchResult result = registry.run("counting", countingBenchmark);
+
+    EXPECT_EQ(result.name, "counting");
+    EXPECT_GT(result.iterations, 1u); // Calibration grew past one op per sample
+    EXPECT_GT(result.ns_per_op, 0.0);
+    EXPECT_GT(result.cycles_per_op, 0.0);
+    EXPECT_GT(result.samples_kept, 0);
+    EXPECT_EQ(result.samples_kept + result.samples_rejected,
+              static_cast<int>(BenchmarkRegistry::kSamples));
+    EXPECT_GT(g_op_count.load(), result.iterations * BenchmarkRegistry::kSamples);
+}
+
+TEST(BenchmarkRegistryTest, RunAllReportsEveryRegisteredBenchmark) {
+    BenchmarkRegistry registry;
+    registry.add("counting_a", countingBenchmark);
+    registry.add("counting_b", countingBenchmark);
+
+    std::ostringstream human;
+    const std::vector<BenchResult> results = registry.runAll(human);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_NE(human.str().find("counting_a"), std::string::npos);
+    EXPECT_NE(human.str().find("ns/op"), std::string::npos);
+
+    std::ostringstream json;
+    BenchmarkRegistry::writeJson(results, json);
+    EXPECT_NE(json.str().find("\"name\": \"counting_b\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"ns_per_op\""), std::string::npos);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../slab_pool.cpp"
+
+namespace {
+
+std::atomic<int> g_constructed{0};
+std::atomic<int> g_destroyed{0};
+
+struct Tracked {
+    int value;
+    explicit Tracked(int v) : value(v) { g_constructed.fetch_add(1, std::memory_order_relaxed); }
+    ~Tracked() { g_destroyed.fetch_add(1, std::memory_order_relaxed); }
+};
+
+} // namespace
+
+TEST(SlabPoolTest, MakeSharedConstructsAndRecyclesOnLastDrop) {
+    g_constructed = 0;
+    g_destroyed = 0;
+    SlabPool<Tracked> pool(8);
+    {
+        SharedPtr<Tracked> ptr = pool.makeShared(42);
+        ASSERT_NE(ptr.get(), nullptr);
+        EXPECT_EQ(ptr->value, 42);
+        EXPECT_EQ(pool.outstanding(), 1u);
+    }
+    EXPECT_EQ(g_constructed.load(), 1);
+    EXPECT_EQ(g_destroyed.load(), 1);
+    EXPECT_EQ(pool.outstanding(), 0u);
+}
+
+TEST(SlabPoolTest, CopiesShareOneCountAndSlot) {
+    SlabPool<Tracked> pool(8);
+    SharedPtr<Tracked> a = pool.makeShared(1);
+    SharedPtr<Tracked> b = a;
+    EXPECT_EQ(a.use_count(), 2);
+    EXPECT_EQ(b.get(), a.get());
+    EXPECT_EQ(pool.outstanding(), 1u); // One slot, however many owners
+    b.release();
+    EXPECT_TRUE(a.unique());
+    EXPECT_EQ(pool.outstanding(), 1u);
+}
+
+TEST(SlabPoolTest, ExhaustionReturnsEmptyAndReleaseRestores) {
+    SlabPool<Tracked> pool(4);
+    std::vector<SharedPtr<Tracked>> held;
+    for (int i = 0; i < 4; ++i) {
+        held.push_back(pool.makeShared(i));
+        ASSERT_NE(held.back().get(), nullptr);
+    }
+    EXPECT_EQ(pool.makeShared(99).get(), nullptr);
+    held.pop_back();
+    SharedPtr<Tracked> again = pool.makeShared(99);
+    EXPECT_NE(again.get(), nullptr);
+    EXPECT_EQ(again->value, 99);
+}
+
+TEST(SlabPoolTest, SteadyStateReusesSlots) {
+    SlabPool<Tracked> pool(4);
+    // Far more messages than slots: each drop must hand its slot back for
+    // the next makeShared, or the pool would run dry immediately.
+    for (int i = 0; i < 1000; ++i) {
+        SharedPtr<Tracked> ptr = pool.makeShared(i);
+        ASSERT_NE(ptr.get(), nullptr);
+        EXPECT_EQ(ptr->value, i);
+    }
+    EXPECT_EQ(pool.outstanding(), 0u);
+}
+
+TEST(SlabPoolTest, CrossThreadProduceConsume) {
+    g_constructed = 0;
+    g_destroyed = 0;
+    constexpr int kMessages = 20000;
+    // Big enough that the producer's thread cache refills don't starve the
+    // consumer-side releases parked in the other thread's cache.
+    SlabPool<Tracked> pool(256);
+
+    std::vector<SharedPtr<Tracked>> inflight;
+    std::mutex inflightMutex;
+    std::atomic<bool> done{false};
+
+    // Producer allocates from the pool, consumer drops — slots migrate
+    // between thread caches through the shared free list.
+    std::thread consumer([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(inflightMutex);
+            inflight.clear(); // Drops run on this thread
+        }
+    });
+    for (int i = 0; i < kMessages; ++i) {
+        SharedPtr<Tracked> msg = pool.makeShared(i);
+        while (msg.get() == nullptr) { // Consumer is behind; wait for slots
+            std::this_thread::yield();
+            msg = pool.makeShared(i);
+        }
+        std::lock_guard<std::mutex> lock(inflightMutex);
+        inflight.push_back(std::move(msg));
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    inflight.clear();
+
+    EXPECT_EQ(g_constructed.load(), kMessages);
+    EXPECT_EQ(g_destroyed.load(), kMessages);
+    EXPECT_EQ(pool.outstanding(), 0u);
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#define TIMER_LINKED_LIST_NO_MAIN
+#include "../timer_linked_list.cpp"
+
+namespace {
+using Millis = std::chrono::milliseconds;
+} // namespace
+
+TEST(PooledTimerListTest, FiresDueTimersInDeadlineOrder) {
+    TimerNodePool pool(4);
+    PooledTimerList list(pool);
+    const TimePoint base = Clock::now();
+
+    std::vector<int> fired;
+    list.addTimer(base, 30, [&fired] { fired.push_back(30); });
+    list.addTimer(base, 10, [&fired] { fired.push_back(10); });
+    list.addTimer(base, 20, [&fired] { fired.push_back(20); });
+
+    list.expireUpTo(base + Millis(15));
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0], 10);
+    list.expireUpTo(base + Millis(100));
+    ASSERT_EQ(fired.size(), 3u);
+    EXPECT_EQ(fired[1], 20);
+    EXPECT_EQ(fired[2], 30);
+}
+
+TEST(TimerNodePoolTest, RecyclesNodesThroughTheFreelist) {
+    TimerNodePool pool(1);
+    PooledTimerNode* first = pool.acquire();
+    pool.release(first);
+    // Reserved one node, released one node: the next acquire must reuse
+    // it rather than touch the allocator.
+    EXPECT_EQ(pool.acquire(), first);
+}
+
+TEST(PooledTimerListTest, FiredNodesReturnToThePool) {
+    TimerNodePool pool(1);
+    PooledTimerList list(pool);
+    const TimePoint base = Clock::now();
+
+    int hits = 0;
+    list.addTimer(base, 1, [&hits] { ++hits; });
+    list.expireUpTo(base + Millis(5));
+    EXPECT_EQ(hits, 1);
+
+    // The fired node went back to the freelist; feeding another timer
+    // through the list reuses it.
+    PooledTimerNode* recycled = pool.acquire();
+    pool.release(recycled);
+    list.addTimer(base, 1, [&hits] { ++hits; });
+    list.expireUpTo(base + Millis(5));
+    EXPECT_EQ(hits, 2);
+}
+
+TEST(TimerWheelTest, FiresInOrderAcrossCascadeBoundaries) {
+    const TimePoint base = Clock::now();
+    TimerWheel wheel(base);
+
+    // Delays straddling the wheel-0/1 boundary (256 ticks) and the
+    // wheel-1/2 boundary (65536 ticks), so timers land in three wheels
+    // and must cascade down before firing.
+    const int delays[] = {3, 255, 256, 257, 65536};
+    constexpr int kCount = std::size(delays);
+    TimerWheel::WheelNode nodes[kCount];
+    std::vector<int> fired;
+    for (int i = 0; i < kCount; ++i) {
+        wheel.addTimer(&nodes[i], base + Millis(delays[i]),
+                       [&fired, i] { fired.push_back(i); });
+    }
+
+    wheel.advanceTo(base + Millis(255));
+    ASSERT_EQ(fired.size(), 2u); // Only the sub-256 timers so far
+    wheel.advanceTo(base + Millis(70000));
+    ASSERT_EQ(fired.size(), static_cast<size_t>(kCount));
+    for (int i = 0; i < kCount; ++i) {
+        EXPECT_EQ(fired[i], i) << "fire order must follow the delays";
+    }
+}
+
+TEST(TimerWheelTest, CancelledTimerNeverFires) {
+    const TimePoint base = Clock::now();
+    TimerWheel wheel(base);
+    bool fired = false;
+    TimerWheel::WheelNode node;
+    wheel.addTimer(&node, base + Millis(500), [&fired] { fired = true; });
+
+    // Advance past the tick-256 cascade so the node has migrated from
+    // wheel 1 into wheel 0 before the cancel — the case the old
+    // wheelFor()-based lock choice got wrong.
+    wheel.advanceTo(base + Millis(300));
+    wheel.cancel(&node);
+    wheel.advanceTo(base + Millis(1000));
+    EXPECT_FALSE(fired);
+}
+
+TEST(HeapTimerDriverTest, DispatchesInDeadlineOrderAndStops) {
+    HeapTimerDriver driver;
+    std::mutex mtx;
+    std::vector<int> fired;
+    auto note = [&](int id) {
+        return [&mtx, &fired, id] {
+            std::lock_guard<std::mutex> lock(mtx);
+            fired.push_back(id);
+        };
+    };
+
+    const TimePoint base = Clock::now();
+    // Out-of-order insertion, including one timer armed after the worker
+    // is already sleeping on a later deadline — it must preempt the sleep.
+    driver.addTimer(base + Millis(40), note(40));
+    driver.addTimer(base + Millis(20), note(20));
+    std::thread worker([&driver] { driver.run(); });
+    driver.addTimer(base + Millis(5), note(5));
+
+    while (driver.pending() > 0) {
+        std::this_thread::sleep_for(Millis(1));
+    }
+    driver.stop();
+    worker.join();
+
+    std::lock_guard<std::mutex> lock(mtx);
+    ASSERT_EQ(fired.size(), 3u);
+    EXPECT_EQ(fired[0], 5);
+    EXPECT_EQ(fired[1], 20);
+    EXPECT_EQ(fired[2], 40);
+}
+
+TEST(HeapTimerDriverTest, CallbackMayArmFollowUpTimer) {
+    HeapTimerDriver driver;
+    std::atomic<int> hops{0};
+    const TimePoint base = Clock::now();
+    driver.addTimer(base + Millis(2), [&] {
+        hops.fetch_add(1);
+        driver.addTimer(base + Millis(4), [&] { hops.fetch_add(1); });
+    });
+
+    std::thread worker([&driver] { driver.run(); });
+    while (hops.load() < 2) {
+        std::this_thread::sleep_for(Millis(1));
+    }
+    driver.stop();
+    worker.join();
+    EXPECT_EQ(hops.load(), 2);
+    EXPECT_EQ(driver.pending(), 0u);
+}
+
+TEST(TimerWheelTest, CancelRacesAdvanceSafely) {
+    const TimePoint base = Clock::now();
+    TimerWheel wheel(base);
+
+    constexpr int kTimers = 2000;
+    std::vector<TimerWheel::WheelNode> nodes(kTimers);
+    std::vector<std::atomic<int>> fireCount(kTimers);
+    for (int i = 0; i < kTimers; ++i) {
+        wheel.addTimer(&nodes[i], base + Millis(1 + i % 700),
+                       [&fireCount, i] {
+                           fireCount[i].fetch_add(1, std::memory_order_relaxed);
+                       });
+    }
+
+    // Cancel every even timer while the advance loop drives cascades and
+    // fires; a cancel may land before or after its fire, but must never
+    // corrupt the lists or fire anything twice.
+    std::thread canceller([&] {
+        for (int i = 0; i < kTimers; i += 2) {
+            wheel.cancel(&nodes[i]);
+        }
+    });
+    for (int t = 1; t <= 800; ++t) {
+        wheel.advanceTo(base + Millis(t));
+    }
+    canceller.join();
+    wheel.advanceTo(base + Millis(800));
+
+    for (int i = 0; i < kTimers; ++i) {
+        if (i % 2 == 1) {
+            EXPECT_EQ(fireCount[i].load(), 1) << "timer " << i;
+        } else {
+            EXPECT_LE(fireCount[i].load(), 1) << "timer " << i;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "../tsc_clock.cpp"
+
+TEST(TscClockTest, CalibratedFrequencyIsPlausible) {
+    const double ghz = TscClock::instance().frequency_ghz();
+    EXPECT_GT(ghz, 0.5);
+    EXPECT_LT(ghz, 10.0);
+}
+
+TEST(TscClockTest, NowNsIsMonotonic) {
+    uint64_t prev = TscClock::instance().now_ns();
+    for (int i = 0; i < 10000; ++i) {
+        const uint64_t now = TscClock::instance().now_ns();
+        ASSERT_GE(now, prev);
+        prev = now;
+    }
+}
+
+TEST(TscClockTest, TracksSteadyClockOverSleep) {
+    auto& clock = TscClock::instance();
+    const uint64_t tsc_start = clock.now_ns();
+    const auto chrono_start = std::chrono::steady_clock::now();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const uint64_t tsc_elapsed = clock.now_ns() - tsc_start;
+    const auto chrono_elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - chrono_start).count();
+
+    // Within 2% of CLOCK_MONOTONIC over 50ms — generous for a fresh 10ms
+    // calibration window.
+    EXPECT_NEAR(static_cast<double>(tsc_elapsed), static_cast<double>(chrono_elapsed),
+                chrono_elapsed * 0.02);
+}
+
+TEST(TscClockTest, DriftCorrectionKeepsClockContinuous) {
+    auto& clock = TscClock::instance();
+    clock.start_drift_correction(10);
+    uint64_t prev = clock.now_ns();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(60);
+    while (std::chrono::steady_clock::now() < deadline) {
+        const uint64_t now = clock.now_ns();
+        ASSERT_GE(now, prev); // No backward jump across multiplier updates
+        prev = now;
+    }
+    clock.stop_drift_correction();
+}
@@ -55,3 +55,128 @@ TEST_F(HashTableTest, RehashIfNeededAfterRemoval) {
     EXPECT_EQ(static_cast<double>(numElements) / tableSize, 0.0);
     EXPECT_EQ(ht.getTableSize(), 8);  // Should be reset to initial size (8)
 }
+
+// Robin Hood variant tests
+class RobinHoodHashTableTest : public ::testing::Test {
+protected:
+    RobinHoodHashTable<int, std::string> ht;
+};
+
+TEST_F(RobinHoodHashTableTest, InsertFindUpdate) {
+    ht.insert(1, "one");
+    ht.insert(2, "two");
+    EXPECT_EQ(ht.find(1).value(), "one");
+    ht.insert(1, "uno");
+    EXPECT_EQ(ht.find(1).value(), "uno");
+    EXPECT_EQ(ht.getSize(), 2u);
+    EXPECT_FALSE(ht.find(99).has_value());
+}
+
+TEST_F(RobinHoodHashTableTest, RemoveDoesNotBreakProbeChains) {
+    // Force long probe chains with colliding keys, then remove from the
+    // middle; backward-shift deletion must keep the rest findable.
+    for (int i = 0; i < 64; ++i) {
+        ht.insert(i * 8, std::to_string(i)); // All hash to similar slots mod 8
+    }
+    for (int i = 0; i < 64; i += 2) {
+        ht.remove(i * 8);
+    }
+    for (int i = 0; i < 64; ++i) {
+        if (i % 2 == 0) {
+            EXPECT_FALSE(ht.find(i * 8).has_value());
+        } else {
+            EXPECT_EQ(ht.find(i * 8).value(), std::to_string(i));
+        }
+    }
+    EXPECT_EQ(ht.getSize(), 32u);
+}
+
+TEST_F(RobinHoodHashTableTest, ChurnWorkload) {
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            ht.insert(i, std::to_string(round * 1000 + i));
+        }
+        for (int i = 0; i < 100; i += 3) {
+            ht.remove(i);
+        }
+        for (int i = 0; i < 100; ++i) {
+            if (i % 3 == 0) {
+                EXPECT_FALSE(ht.find(i).has_value());
+            } else {
+                EXPECT_EQ(ht.find(i).value(), std::to_string(round * 1000 + i));
+            }
+        }
+        for (int i = 0; i < 100; ++i) {
+            ht.remove(i);
+        }
+    }
+    EXPECT_EQ(ht.getSize(), 0u);
+}
+
+// Flat (swisstable-style) layout tests
+class FlatHashTableTest : public ::testing::Test {
+protected:
+    FlatHashTable<int, std::string> ht;
+};
+
+TEST_F(FlatHashTableTest, InsertFindRemove) {
+    ht.insert(1, "one");
+    ht.insert(2, "two");
+    EXPECT_EQ(ht.find(1).value(), "one");
+    ht.insert(1, "uno");
+    EXPECT_EQ(ht.find(1).value(), "uno");
+    EXPECT_EQ(ht.getSize(), 2u);
+    ht.remove(1);
+    EXPECT_FALSE(ht.find(1).has_value());
+    EXPECT_EQ(ht.find(2).value(), "two");
+}
+
+TEST_F(FlatHashTableTest, GrowsPastGroupBoundaries) {
+    for (int i = 0; i < 1000; ++i) {
+        ht.insert(i, std::to_string(i));
+    }
+    EXPECT_EQ(ht.getSize(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(ht.find(i).value(), std::to_string(i));
+    }
+    EXPECT_FALSE(ht.find(1000).has_value());
+}
+
+TEST_F(FlatHashTableTest, ReinsertDisplacedKeyAfterRemove) {
+    // std::hash<int> is the identity and the group index drops the low 7
+    // bits, so keys 0..16 all target group 0 of a 32-slot table: the first
+    // 16 fill the group and key 16 spills into the next one. Deleting a
+    // group-0 key then opens a tombstone *before* the spilled key's slot;
+    // re-inserting key 16 must find and update the existing entry, not
+    // claim the tombstone and create a duplicate.
+    FlatHashTable<int, std::string> wide(32);
+    for (int i = 0; i <= 16; ++i) {
+        wide.insert(i, std::to_string(i));
+    }
+    wide.remove(3);
+    wide.insert(16, "updated");
+    EXPECT_EQ(wide.find(16).value(), "updated");
+    EXPECT_EQ(wide.getSize(), 16u);
+
+    // A single remove must make the key a miss — a duplicate would
+    // resurface the stale copy here.
+    wide.remove(16);
+    EXPECT_FALSE(wide.find(16).has_value());
+}
+
+TEST_F(FlatHashTableTest, RemoveUnderCollisions) {
+    // Keys spaced by the group count collide into the same groups.
+    for (int i = 0; i < 200; ++i) {
+        ht.insert(i * 16, std::to_string(i));
+    }
+    for (int i = 0; i < 200; i += 2) {
+        ht.remove(i * 16);
+    }
+    for (int i = 0; i < 200; ++i) {
+        if (i % 2 == 0) {
+            EXPECT_FALSE(ht.find(i * 16).has_value());
+        } else {
+            EXPECT_EQ(ht.find(i * 16).value(), std::to_string(i));
+        }
+    }
+}
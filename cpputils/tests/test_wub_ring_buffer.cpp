@@ -74,8 +74,117 @@ TEST_F(LocklessRingBufferTest, FullAndEmptyStates) {
     EXPECT_FALSE(buffer->is_full());
 }
 
+TEST_F(LocklessRingBufferTest, CapacityPreservedAcrossWraparound) {
+    // Drive the indices well past the power-of-two storage size so the
+    // masked slot calculation and cached indices are both exercised.
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_TRUE(buffer->push(round * 5 + i));
+        }
+        EXPECT_TRUE(buffer->is_full());
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_EQ(buffer->pop(), round * 5 + i);
+        }
+        EXPECT_TRUE(buffer->is_empty());
+    }
+}
+
+TEST_F(LocklessRingBufferTest, SpscThreadedTransfer) {
+    LocklessRingBuffer<int> rb(1024);
+    constexpr int kCount = 100000;
+    std::thread producer([&rb]() {
+        for (int i = 0; i < kCount; ++i) {
+            while (!rb.push(i)) {}
+        }
+    });
+    int expected = 0;
+    while (expected < kCount) {
+        auto v = rb.pop();
+        if (v.has_value()) {
+            ASSERT_EQ(*v, expected);
+            ++expected;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(rb.is_empty());
+}
+
+TEST_F(LocklessRingBufferTest, PushNPopNBatch) {
+    std::vector<int> in = {1, 2, 3, 4, 5, 6, 7};
+    EXPECT_EQ(buffer->push_n(in), 5u); // Only capacity slots fit
+    EXPECT_TRUE(buffer->is_full());
+
+    int out[8] = {};
+    EXPECT_EQ(buffer->pop_n(out, 8), 5u);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(out[i], in[i]);
+    }
+    EXPECT_TRUE(buffer->is_empty());
+    EXPECT_EQ(buffer->pop_n(out, 8), 0u);
+}
+
+TEST_F(LocklessRingBufferTest, BatchHandlesWraparound) {
+    LocklessRingBuffer<int> rb(8);
+    int out[8] = {};
+    // Offset the indices so batch copies straddle the end of storage.
+    for (int round = 0; round < 20; ++round) {
+        std::vector<int> in = {round, round + 1, round + 2, round + 3, round + 4};
+        EXPECT_EQ(rb.push_n(in), in.size());
+        EXPECT_EQ(rb.pop_n(out, 8), in.size());
+        for (size_t i = 0; i < in.size(); ++i) {
+            EXPECT_EQ(out[i], in[i]);
+        }
+    }
+}
+
 TEST_F(LocklessRingBufferTest, SizeMustBeGreaterThanZero) {
     EXPECT_THROW(new LocklessRingBuffer<int>(0), std::invalid_argument);
     EXPECT_THROW(new LocklessRingBuffer<int>(-1), std::invalid_argument);
 }
 
+
+TEST(MpmcRingBufferTest, BasicPushPop) {
+    MpmcRingBuffer<int> rb(8);
+    EXPECT_TRUE(rb.is_empty());
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(rb.push(i));
+    }
+    EXPECT_FALSE(rb.push(8)); // Full
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(rb.pop(), i);
+    }
+    EXPECT_FALSE(rb.pop().has_value());
+}
+
+TEST(MpmcRingBufferTest, MultiProducerMultiConsumer) {
+    MpmcRingBuffer<int> rb(256);
+    constexpr int kProducers = 4, kConsumers = 4, kPerProducer = 25000;
+    std::atomic<long> sum{0};
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&rb, p]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                while (!rb.push(p * kPerProducer + i)) {}
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&rb, &sum, &consumed]() {
+            while (consumed.load() < kProducers * kPerProducer) {
+                auto v = rb.pop();
+                if (v.has_value()) {
+                    sum.fetch_add(*v);
+                    consumed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    const long total = kProducers * kPerProducer;
+    EXPECT_EQ(consumed.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    EXPECT_TRUE(rb.is_empty());
+}
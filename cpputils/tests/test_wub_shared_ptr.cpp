@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <thread>
 #include "../wub_shared_ptr.cpp"
 
 // Test fixture class
@@ -166,4 +167,127 @@ TEST_F(SharedPtrTest, MyMakeSharedReleaseOwnership) {
     EXPECT_EQ(ptr1.get(), nullptr);
     EXPECT_EQ(ptr1.use_count(), 0);
     EXPECT_EQ(ptr2.use_count(), 1);
-}
\ No newline at end of file
+}
+// Hazard-pointer read path tests
+
+TEST_F(SharedPtrTest, HazardPtrProtectsAgainstRetire) {
+    std::atomic<int*> source{new int(123)};
+    {
+        HazardPtr<int> guard(source);
+        EXPECT_EQ(*guard, 123);
+
+        // Writer swaps in a new object and retires the old one while the
+        // reader still holds its guard; the scan must not reclaim it.
+        int* old = source.exchange(new int(456));
+        HazardDomain::instance().retire(old);
+        HazardDomain::instance().scan();
+        EXPECT_EQ(*guard, 123); // Still alive and unchanged
+    }
+    // Guard released: the retired object is reclaimable now.
+    HazardDomain::instance().scan();
+    int* last = source.exchange(nullptr);
+    HazardDomain::instance().retire(last);
+    HazardDomain::instance().scan();
+}
+
+TEST_F(SharedPtrTest, NestedHazardGuardsProtectBothObjects) {
+    std::atomic<int*> sourceA{new int(1)};
+    std::atomic<int*> sourceB{new int(2)};
+    {
+        HazardPtr<int> outer(sourceA);
+        {
+            // The inner guard must land in its own slot; if it reused the
+            // outer guard's slot, A would lose its protection below.
+            HazardPtr<int> inner(sourceB);
+            int* oldA = sourceA.exchange(new int(3));
+            int* oldB = sourceB.exchange(new int(4));
+            HazardDomain::instance().retire(oldA);
+            HazardDomain::instance().retire(oldB);
+            HazardDomain::instance().scan();
+            EXPECT_EQ(*outer, 1);
+            EXPECT_EQ(*inner, 2);
+        }
+        HazardDomain::instance().scan();
+        EXPECT_EQ(*outer, 1); // A stays protected after the inner release
+    }
+    HazardDomain::instance().scan();
+    HazardDomain::instance().retire(sourceA.exchange(nullptr));
+    HazardDomain::instance().retire(sourceB.exchange(nullptr));
+    HazardDomain::instance().scan();
+}
+
+TEST_F(SharedPtrTest, HazardPtrConcurrentReadersAndWriter) {
+    std::atomic<int*> source{new int(0)};
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&source, &stop]() {
+            while (!stop.load()) {
+                HazardPtr<int> guard(source);
+                // The value must always be a published one, never freed memory.
+                volatile int v = *guard;
+                (void)v;
+            }
+        });
+    }
+
+    for (int i = 1; i <= 1000; ++i) {
+        int* old = source.exchange(new int(i));
+        HazardDomain::instance().retire(old);
+    }
+    stop.store(true);
+    for (auto& t : readers) t.join();
+
+    int* last = source.exchange(nullptr);
+    HazardDomain::instance().retire(last);
+    HazardDomain::instance().scan();
+}
+
+// Intrusive refcounting tests
+
+struct IntrusiveMessage : IntrusiveRefCount {
+    int sequence;
+    double price;
+    IntrusiveMessage(int s, double p) : sequence(s), price(p) {}
+};
+
+TEST_F(SharedPtrTest, IntrusiveBasicConstruction) {
+    auto ptr = make_intrusive<IntrusiveMessage>(1, 101.5);
+    EXPECT_EQ(ptr->sequence, 1);
+    EXPECT_EQ(ptr->price, 101.5);
+    EXPECT_EQ(ptr.use_count(), 1);
+    EXPECT_TRUE(ptr.unique());
+}
+
+TEST_F(SharedPtrTest, IntrusiveCopyAndMove) {
+    auto ptr1 = make_intrusive<IntrusiveMessage>(2, 99.0);
+    IntrusiveSharedPtr<IntrusiveMessage> ptr2(ptr1);
+    EXPECT_EQ(ptr1.use_count(), 2);
+    EXPECT_EQ(ptr2.use_count(), 2);
+
+    IntrusiveSharedPtr<IntrusiveMessage> ptr3(std::move(ptr2));
+    EXPECT_EQ(ptr2.get(), nullptr);
+    EXPECT_EQ(ptr3.use_count(), 2);
+    EXPECT_EQ(ptr3->sequence, 2);
+}
+
+TEST_F(SharedPtrTest, IntrusiveReleaseOwnership) {
+    auto ptr1 = make_intrusive<IntrusiveMessage>(3, 50.0);
+    IntrusiveSharedPtr<IntrusiveMessage> ptr2 = ptr1;
+    EXPECT_EQ(ptr1.use_count(), 2);
+
+    ptr1.release();
+    EXPECT_EQ(ptr1.get(), nullptr);
+    EXPECT_EQ(ptr1.use_count(), 0);
+    EXPECT_EQ(ptr2.use_count(), 1);
+}
+
+TEST_F(SharedPtrTest, IntrusiveCountIsPerObject) {
+    auto ptr1 = make_intrusive<IntrusiveMessage>(4, 1.0);
+    // Copying the payload must not copy the refcount.
+    auto ptr2 = make_intrusive<IntrusiveMessage>(*ptr1);
+    EXPECT_EQ(ptr1.use_count(), 1);
+    EXPECT_EQ(ptr2.use_count(), 1);
+    EXPECT_EQ(ptr2->sequence, 4);
+}
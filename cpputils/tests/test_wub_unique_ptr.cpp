@@ -65,3 +65,84 @@ TEST(UniquePtrTest, CopyConstructor) {
     // UniquePtr<MyClass> copy(ptr); // This should fail to compile if UniquePtr is non-copyable
 }
 
+TEST(UniquePtrTest, EmptyDeleterKeepsPointerSize) {
+    // The whole point of the [[no_unique_address]] deleter storage: with a
+    // stateless deleter the smart pointer is exactly one pointer wide.
+    EXPECT_EQ(sizeof(UniquePtr<MyClass>), sizeof(MyClass*));
+    EXPECT_EQ(sizeof(UniquePtr<MyClass[]>), sizeof(MyClass*));
+}
+
+namespace {
+
+struct CountingDeleter {
+    void operator()(int* ptr) const {
+        ++deletions;
+        delete ptr;
+    }
+    static int deletions;
+};
+int CountingDeleter::deletions = 0;
+
+// Pool-style stateful deleter: returns the object to a "pool" counter
+// instead of the heap.
+struct PoolDeleter {
+    int* returned = nullptr;
+    void operator()(int* ptr) const {
+        ++*returned;
+        delete ptr;
+    }
+};
+
+struct Tracked {
+    static inline int alive = 0;
+    Tracked() { ++alive; }
+    ~Tracked() { --alive; }
+};
+
+} // namespace
+
+TEST(UniquePtrTest, CustomDeleterInvoked) {
+    CountingDeleter::deletions = 0;
+    {
+        UniquePtr<int, CountingDeleter> ptr(new int(42));
+        EXPECT_EQ(*ptr, 42);
+    }
+    EXPECT_EQ(CountingDeleter::deletions, 1);
+}
+
+TEST(UniquePtrTest, StatefulDeleterMovesWithPointer) {
+    int returns = 0;
+    UniquePtr<int, PoolDeleter> ptr1(new int(7), PoolDeleter{&returns});
+    UniquePtr<int, PoolDeleter> ptr2(std::move(ptr1));
+    EXPECT_EQ(ptr2.get_deleter().returned, &returns);
+    ptr2.reset();
+    EXPECT_EQ(returns, 1);
+}
+
+TEST(UniquePtrArrayTest, IndexingAndReset) {
+    UniquePtr<int[]> arr(new int[4]{10, 20, 30, 40});
+    EXPECT_EQ(arr[0], 10);
+    EXPECT_EQ(arr[3], 40);
+    arr[1] = 25;
+    EXPECT_EQ(arr[1], 25);
+    arr.reset(new int[2]{1, 2});
+    EXPECT_EQ(arr[1], 2);
+}
+
+TEST(UniquePtrArrayTest, DestroysEveryElement) {
+    static_assert(!std::is_trivially_destructible_v<Tracked>);
+    Tracked::alive = 0;
+    {
+        UniquePtr<Tracked[]> arr(new Tracked[3]);
+        EXPECT_EQ(Tracked::alive, 3);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(UniquePtrArrayTest, MoveTransfersOwnership) {
+    UniquePtr<int[]> arr1(new int[2]{5, 6});
+    UniquePtr<int[]> arr2(std::move(arr1));
+    EXPECT_EQ(arr1.get(), nullptr);
+    EXPECT_EQ(arr2[1], 6);
+}
+
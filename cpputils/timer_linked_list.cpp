@@ -8,6 +8,15 @@
 #include <iomanip>
 #include <ctime>
 #include <memory>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <tuple>
+#include <type_traits>
+
+#include "intrusive_ll.cpp"
 
 using Clock = std::chrono::steady_clock;
 using TimePoint = Clock::time_point;
@@ -81,8 +90,492 @@ private:
     bool stop;
 };
 
+// Fixed-size inline callback storage: a FunctionRef-style replacement for the
+// std::function in TimerNode, which heap-allocates for any capture larger
+// than the small-object buffer. Callables must fit the inline buffer (a few
+// pointers of captured state is plenty for timer callbacks); oversized ones
+// are rejected at compile time rather than silently allocating.
+class InlineCallback {
+public:
+    static constexpr size_t kStorageSize = 48;
+
+    InlineCallback() = default;
+    ~InlineCallback() { reset(); }
+
+    InlineCallback(const InlineCallback&) = delete;
+    InlineCallback& operator=(const InlineCallback&) = delete;
+
+    template<typename F>
+    void assign(F&& fn) {
+        using Callable = std::decay_t<F>;
+        static_assert(sizeof(Callable) <= kStorageSize, "Callback capture too large for inline storage");
+        reset();
+        new (storage) Callable(std::forward<F>(fn));
+        invoke = [](void* s) { (*static_cast<Callable*>(s))(); };
+        destroy = [](void* s) { static_cast<Callable*>(s)->~Callable(); };
+    }
+
+    void operator()() { invoke(storage); }
+
+    void reset() {
+        if (destroy) {
+            destroy(storage);
+            invoke = nullptr;
+            destroy = nullptr;
+        }
+    }
+
+private:
+    alignas(std::max_align_t) char storage[kStorageSize];
+    void (*invoke)(void*) = nullptr;
+    void (*destroy)(void*) = nullptr;
+};
+
+// Caller-owned timer node for the zero-allocation path: lives in a pool,
+// carries its callback inline, and links intrusively.
+struct PooledTimerNode {
+    PooledTimerNode* next = nullptr;
+    TimePoint expirationTime;
+    InlineCallback callback;
+};
+
+// Freelist recycling PooledTimerNodes. Nodes are heap-allocated only when the
+// freelist is empty, so after warmup (or an up-front reserve) the steady-state
+// timer path never touches the allocator.
+class TimerNodePool {
+public:
+    explicit TimerNodePool(size_t reserveCount = 0) {
+        for (size_t i = 0; i < reserveCount; ++i) {
+            release(new PooledTimerNode());
+        }
+    }
+
+    ~TimerNodePool() {
+        while (freeList) {
+            PooledTimerNode* node = freeList;
+            freeList = node->next;
+            delete node;
+        }
+    }
+
+    PooledTimerNode* acquire() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (freeList) {
+            PooledTimerNode* node = freeList;
+            freeList = node->next;
+            node->next = nullptr;
+            return node;
+        }
+        return new PooledTimerNode();
+    }
+
+    void release(PooledTimerNode* node) {
+        node->callback.reset();
+        std::lock_guard<std::mutex> lock(mtx);
+        node->next = freeList;
+        freeList = node;
+    }
+
+private:
+    std::mutex mtx;
+    PooledTimerNode* freeList = nullptr;
+};
+
+// TimerList counterpart working purely on pooled intrusive nodes: addTimer
+// links a caller-acquired node (no make_unique, no std::function), and fired
+// nodes go straight back to the pool.
+class PooledTimerList {
+public:
+    explicit PooledTimerList(TimerNodePool& pool) : pool(pool) {}
+
+    template<typename F>
+    void addTimer(TimePoint start, int intervalMillis, F&& callback) {
+        PooledTimerNode* node = pool.acquire();
+        node->expirationTime = start + std::chrono::milliseconds(intervalMillis);
+        node->callback.assign(std::forward<F>(callback));
+
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!head || node->expirationTime < head->expirationTime) {
+            node->next = head;
+            head = node;
+        } else {
+            PooledTimerNode* current = head;
+            while (current->next && current->next->expirationTime < node->expirationTime) {
+                current = current->next;
+            }
+            node->next = current->next;
+            current->next = node;
+        }
+    }
+
+    // Fire everything due by `now`; each expired node returns to the pool.
+    void expireUpTo(TimePoint now) {
+        while (true) {
+            PooledTimerNode* expired = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (!head || head->expirationTime > now) {
+                    return;
+                }
+                expired = head;
+                head = head->next;
+            }
+            expired->callback();
+            pool.release(expired);
+        }
+    }
+
+private:
+    TimerNodePool& pool;
+    std::mutex mtx;
+    PooledTimerNode* head = nullptr;
+};
+
+// Hierarchical timer wheel: O(1) insert/cancel instead of TimerList's O(n)
+// sorted walk. Each wheel level covers 256 ticks of the level below; a timer
+// lands in the wheel whose resolution covers its remaining delay and cascades
+// down as the wheels turn. Slots are intrusive ListHead chains, so insertion
+// is two pointer writes, and each wheel has its own lock so producer threads
+// inserting at different horizons don't contend.
+class TimerWheel {
+public:
+    struct WheelNode {
+        // Must stay the first member: nodeFrom() recovers the node from a
+        // ListHead* by pointer identity. (The std::function member makes
+        // the type non-standard-layout, so offsetof() would only be
+        // conditionally supported here.)
+        ListHead link;
+        uint64_t expiryTick = 0;
+        TimerCallback callback;
+    };
+
+    explicit TimerWheel(TimePoint start, int tickMillis = 1)
+        : startTime(start), tickDuration(std::chrono::milliseconds(tickMillis)), currentTick(0) {}
+
+    // O(1): pick the wheel covering the remaining delay, link into its slot.
+    void addTimer(WheelNode* node, TimePoint expiration, TimerCallback callback) {
+        node->callback = std::move(callback);
+        node->expiryTick = tickFor(expiration);
+        schedule(node);
+    }
+
+    // O(1) unlink, taken under every wheel lock: cascading moves nodes
+    // between wheels, so recomputing the wheel from the current tick can
+    // pick a mutex the node no longer lives under and race advanceTo().
+    // Cancels are rare; the cost is bounded by kWheels mutexes. A
+    // callback that is already firing is not waited for.
+    void cancel(WheelNode* node) {
+        std::apply(
+            [&](auto&... mutexes) {
+                std::scoped_lock lock(mutexes...);
+                node->link.remove();
+            },
+            wheelMutex);
+    }
+
+    // Advance the wheels up to `now`, firing every expired callback.
+    // Single-threaded (one advance thread); producers may addTimer() and
+    // cancel() concurrently.
+    void advanceTo(TimePoint now) {
+        const uint64_t targetTick = tickFor(now);
+        while (currentTick.load(std::memory_order_relaxed) < targetTick) {
+            currentTick.fetch_add(1, std::memory_order_relaxed);
+            cascadeIfNeeded();
+            fireSlot();
+        }
+    }
+
+private:
+    static constexpr size_t kWheelBits = 8;
+    static constexpr size_t kSlotsPerWheel = 1 << kWheelBits; // 256
+    static constexpr size_t kWheels = 4;
+
+    TimePoint startTime;
+    Clock::duration tickDuration;
+    // Atomic: producer threads read it in wheelFor() while the advance
+    // thread increments; a slightly stale read just lands the timer one
+    // wheel high, where the next cascade corrects it.
+    std::atomic<uint64_t> currentTick;
+    std::array<std::array<ListHead, kSlotsPerWheel>, kWheels> wheels;
+    std::array<std::mutex, kWheels> wheelMutex;
+
+    uint64_t tickFor(TimePoint t) const {
+        if (t <= startTime) return 0;
+        return static_cast<uint64_t>((t - startTime) / tickDuration);
+    }
+
+    size_t wheelFor(uint64_t expiryTick) const {
+        const uint64_t tick = currentTick.load(std::memory_order_relaxed);
+        const uint64_t delta = expiryTick > tick ? expiryTick - tick : 0;
+        for (size_t w = 0; w < kWheels - 1; ++w) {
+            if (delta < (uint64_t{1} << (kWheelBits * (w + 1)))) {
+                return w;
+            }
+        }
+        return kWheels - 1;
+    }
+
+    void schedule(WheelNode* node) {
+        const size_t w = wheelFor(node->expiryTick);
+        const size_t slot = (node->expiryTick >> (kWheelBits * w)) & (kSlotsPerWheel - 1);
+        std::lock_guard<std::mutex> lock(wheelMutex[w]);
+        node->link.add_tail(&wheels[w][slot]);
+    }
+
+    // Re-link `node` into the wheel covering its remaining delay while the
+    // caller already holds wheel `heldWheel`'s lock. Cascading only moves
+    // timers to the same or a lower wheel, so the nested acquisition order
+    // is strictly descending; that cannot deadlock against schedule()'s
+    // single lock or cancel()'s std::scoped_lock (which is itself
+    // deadlock-avoiding).
+    void scheduleLocked(WheelNode* node, size_t heldWheel) {
+        const size_t w = wheelFor(node->expiryTick);
+        const size_t slot = (node->expiryTick >> (kWheelBits * w)) & (kSlotsPerWheel - 1);
+        if (w == heldWheel) {
+            node->link.add_tail(&wheels[w][slot]);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(wheelMutex[w]);
+        node->link.add_tail(&wheels[w][slot]);
+    }
+
+    // When a lower wheel completes a revolution, pull the next slot of the
+    // wheel above apart and re-schedule its timers at finer resolution.
+    // The source wheel's lock is held across the whole move so a node is
+    // never observable outside any lock — otherwise cancel() could race
+    // the relink.
+    void cascadeIfNeeded() {
+        const uint64_t tick = currentTick.load(std::memory_order_relaxed);
+        for (size_t w = 1; w < kWheels; ++w) {
+            if ((tick & ((uint64_t{1} << (kWheelBits * w)) - 1)) != 0) {
+                break;
+            }
+            const size_t slot = (tick >> (kWheelBits * w)) & (kSlotsPerWheel - 1);
+            std::lock_guard<std::mutex> lock(wheelMutex[w]);
+            while (!wheels[w][slot].empty()) {
+                ListHead* entry = wheels[w][slot].next;
+                entry->remove();
+                scheduleLocked(nodeFrom(entry), w);
+            }
+        }
+    }
+
+    void fireSlot() {
+        const uint64_t tick = currentTick.load(std::memory_order_relaxed);
+        const size_t slot = tick & (kSlotsPerWheel - 1);
+        for (;;) {
+            WheelNode* due = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(wheelMutex[0]);
+                for (ListHead* entry = wheels[0][slot].next;
+                     entry != &wheels[0][slot]; entry = entry->next) {
+                    // Timers due on a later revolution share the slot; skip.
+                    if (nodeFrom(entry)->expiryTick <= tick) {
+                        entry->remove();
+                        due = nodeFrom(entry);
+                        break;
+                    }
+                }
+            }
+            if (due == nullptr) {
+                break;
+            }
+            // Outside the lock so the callback may add new timers. The node
+            // is already unlinked, so a concurrent cancel() degrades to a
+            // harmless self-unlink; it does not stop this in-flight fire.
+            due->callback();
+        }
+    }
+
+    static WheelNode* nodeFrom(ListHead* head) {
+        // `link` is the first member, so the ListHead and its WheelNode
+        // share an address.
+        return reinterpret_cast<WheelNode*>(head);
+    }
+};
+
+#include <condition_variable>
+#include <vector>
+
+// Deadline-driven worker: TimerList::tick spins (and the poll-loop variant
+// sleeps a fixed 1ms), so dispatch latency is quantized to the poll interval
+// and an idle list still burns a wakeup per quantum. Here the worker does a
+// cv.wait_until the earliest deadline — it sleeps exactly as long as the
+// front timer allows, wakes with scheduler accuracy (tens of µs, not ±1ms),
+// and blocks indefinitely when no timers are armed. addTimer only notifies
+// when the new timer becomes the earliest, so feeding timers behind the
+// front never disturbs the sleeper.
+//
+// Deadlines live in a 4-ary heap rather than a binary one: the tree is half
+// as deep and the four children of a node sit in adjacent vector slots, so a
+// sift-down reads one cache line per level instead of two scattered ones.
+class HeapTimerDriver {
+public:
+    void addTimer(TimePoint expiration, TimerCallback callback) {
+        std::lock_guard<std::mutex> lock(mtx);
+        heap.push_back(HeapEntry{expiration, std::move(callback)});
+        const bool newEarliest = siftUp(heap.size() - 1) == 0;
+        if (newEarliest) {
+            cv.notify_one(); // Sleeper's deadline just moved closer
+        }
+    }
+
+    // Worker loop: dispatch timers as they come due, sleeping until the next
+    // deadline in between. Returns after stop().
+    void run() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (!stopped) {
+            if (heap.empty()) {
+                cv.wait(lock); // Zero CPU while idle
+                continue;
+            }
+            const TimePoint deadline = heap.front().expirationTime;
+            if (Clock::now() < deadline) {
+                cv.wait_until(lock, deadline);
+                continue; // Re-check: an earlier timer or stop() may have arrived
+            }
+            HeapEntry due = popTop();
+            lock.unlock();
+            due.callback(); // Outside the lock; callbacks may addTimer
+            lock.lock();
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopped = true;
+        }
+        cv.notify_one();
+    }
+
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return heap.size();
+    }
+
+private:
+    static constexpr size_t kArity = 4;
+
+    struct HeapEntry {
+        TimePoint expirationTime;
+        TimerCallback callback;
+    };
+
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<HeapEntry> heap;
+    bool stopped = false;
+
+    // Returns the entry's final index so the caller can tell when the new
+    // timer displaced the front.
+    size_t siftUp(size_t index) {
+        while (index > 0) {
+            const size_t parent = (index - 1) / kArity;
+            if (heap[parent].expirationTime <= heap[index].expirationTime) {
+                break;
+            }
+            std::swap(heap[parent], heap[index]);
+            index = parent;
+        }
+        return index;
+    }
+
+    void siftDown(size_t index) {
+        for (;;) {
+            const size_t firstChild = index * kArity + 1;
+            if (firstChild >= heap.size()) {
+                return;
+            }
+            size_t earliest = index;
+            const size_t lastChild = std::min(firstChild + kArity, heap.size());
+            for (size_t child = firstChild; child < lastChild; ++child) {
+                if (heap[child].expirationTime < heap[earliest].expirationTime) {
+                    earliest = child;
+                }
+            }
+            if (earliest == index) {
+                return;
+            }
+            std::swap(heap[index], heap[earliest]);
+            index = earliest;
+        }
+    }
+
+    HeapEntry popTop() {
+        HeapEntry top = std::move(heap.front());
+        heap.front() = std::move(heap.back());
+        heap.pop_back();
+        if (!heap.empty()) {
+            siftDown(0);
+        }
+        return top;
+    }
+};
+
+// Seqlock-published OHLCV store. Guarding every bar read with the writer's
+// mutex makes dozens of strategy threads serialize against the timer
+// thread for a five-field copy; with reads outnumbering writes ~100:1
+// that mutex is almost pure reader-vs-reader contention. Instead the bar
+// is published under a sequence counter: the writer bumps it odd before
+// mutating and even after, and a reader copies the bar and retries if the
+// counter changed (or was odd) around its copy. Readers never block the
+// writer and never touch a lock; a torn read costs one retry.
+//
+// Updates are serialized by a writer-side mutex — both the data thread
+// (ticks) and the timer thread (bar rollover) write — but only writers
+// ever take it, so at our write rate it is uncontended noise. OHLCV must
+// stay trivially copyable: readers copy it while it may be mid-rewrite.
+class SeqlockOHLCVStore {
+    static_assert(std::is_trivially_copyable_v<OHLCV>,
+                  "Readers copy the bar while the writer may be rewriting it");
+
+public:
+    // Writer side: mutate the bar in place under the sequence counter.
+    template<typename UpdateFn>
+    void update(UpdateFn&& fn) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        const uint64_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed); // Odd: writing
+        std::atomic_thread_fence(std::memory_order_release);
+        fn(bar);
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Writer side, bar rollover: take the finished bar and reset for the
+    // next interval, as one atomic (to readers) transition.
+    OHLCV exchangeReset() {
+        OHLCV finished;
+        update([&](OHLCV& b) {
+            finished = b;
+            b = OHLCV();
+        });
+        return finished;
+    }
+
+    // Reader side: lock-free snapshot of the live bar.
+    OHLCV read() const {
+        for (;;) {
+            const uint64_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue; // Mid-write; the writer finishes promptly
+            }
+            OHLCV copy = bar;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) {
+                return copy;
+            }
+        }
+    }
+
+private:
+    std::atomic<uint64_t> sequence{0};
+    OHLCV bar{};
+    std::mutex writerMutex; // Writers only; readers never touch it
+};
+
 // Mock packet processing function to simulate incoming market data
-void mockProcessPacket(OHLCV &ohlcv, std::mutex &ohlcvMutex) {
+void mockProcessPacket(SeqlockOHLCVStore &store) {
     static std::mt19937 rng(static_cast<unsigned>(std::time(nullptr)));
     static std::uniform_real_distribution<double> priceDist(100.0, 200.0);
     static std::uniform_int_distribution<uint64_t> volumeDist(1, 1000);
@@ -90,23 +583,18 @@ void mockProcessPacket(OHLCV &ohlcv, std::mutex &ohlcvMutex) {
     double price = priceDist(rng);
     uint64_t volume = volumeDist(rng);
 
-    std::lock_guard<std::mutex> lock(ohlcvMutex);
-
-    if (ohlcv.open == 0.0) ohlcv.open = price;
-    ohlcv.high = std::max(ohlcv.high, price);
-    ohlcv.low = (ohlcv.low == 0.0) ? price : std::min(ohlcv.low, price);
-    ohlcv.close = price;
-    ohlcv.volume += volume;
+    store.update([&](OHLCV& ohlcv) {
+        if (ohlcv.open == 0.0) ohlcv.open = price;
+        ohlcv.high = std::max(ohlcv.high, price);
+        ohlcv.low = (ohlcv.low == 0.0) ? price : std::min(ohlcv.low, price);
+        ohlcv.close = price;
+        ohlcv.volume += volume;
+    });
 }
 
 // Function to output OHLCV bar
-void outputOHLCV(OHLCV &ohlcv, std::mutex &ohlcvMutex) {
-    OHLCV ohlcvCopy;
-    {
-        std::lock_guard<std::mutex> lock(ohlcvMutex);
-        ohlcvCopy = ohlcv;
-        ohlcv = OHLCV();
-    }
+void outputOHLCV(SeqlockOHLCVStore &store) {
+    OHLCV ohlcvCopy = store.exchangeReset();
 
     auto now = std::chrono::system_clock::now();
     std::time_t now_c = std::chrono::system_clock::to_time_t(now);
@@ -118,10 +606,10 @@ void outputOHLCV(OHLCV &ohlcv, std::mutex &ohlcvMutex) {
               << ", Volume=" << ohlcvCopy.volume << std::endl;
 }
 
+#ifndef TIMER_LINKED_LIST_NO_MAIN
 int main() {
     TimerList timerList;
-    OHLCV ohlcvData;
-    std::mutex ohlcvMutex;
+    SeqlockOHLCVStore ohlcvStore;
     std::atomic<bool> running(true);
 
     // Define market start and end times on the current date
@@ -155,8 +643,8 @@ int main() {
     // Set timers for each second during market hours
     int intervalMillis = 1000;
     for (auto elapsed = startDuration; elapsed < endDuration; elapsed += std::chrono::milliseconds(intervalMillis)) {
-        timerList.addTimer(Clock::now() + elapsed, intervalMillis, [&ohlcvData, &ohlcvMutex]() {
-            outputOHLCV(ohlcvData, ohlcvMutex);
+        timerList.addTimer(Clock::now() + elapsed, intervalMillis, [&ohlcvStore]() {
+            outputOHLCV(ohlcvStore);
         });
     }
     std::cout << "timer set" << std::endl;
@@ -165,13 +653,28 @@ int main() {
     std::thread timerThread(&TimerList::tick, &timerList);
 
     // Simulate receiving data packets in a separate thread
-    std::thread dataThread([&ohlcvData, &ohlcvMutex, &running]() {
+    std::thread dataThread([&ohlcvStore, &running]() {
         while (running) {
-            mockProcessPacket(ohlcvData, ohlcvMutex);
+            mockProcessPacket(ohlcvStore);
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
     });
 
+    // Strategy-side readers: each polls the live bar with a lock-free
+    // read(); torn reads retry internally and the writers never notice.
+    std::atomic<uint64_t> totalReads{0};
+    std::vector<std::thread> strategyThreads;
+    for (int i = 0; i < 4; ++i) {
+        strategyThreads.emplace_back([&ohlcvStore, &running, &totalReads]() {
+            double maxHighSeen = 0.0;
+            while (running) {
+                maxHighSeen = std::max(maxHighSeen, ohlcvStore.read().high);
+                totalReads.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+    }
+
     // Run the simulation for the market hours duration
     std::this_thread::sleep_for(endDuration);
     running = false;
@@ -180,6 +683,12 @@ int main() {
     // Clean up
     timerThread.join();
     dataThread.join();
+    for (auto& t : strategyThreads) {
+        t.join();
+    }
+    std::cout << "Strategy threads made " << totalReads.load()
+              << " lock-free bar reads." << std::endl;
 
     return 0;
 }
+#endif // TIMER_LINKED_LIST_NO_MAIN
@@ -0,0 +1,158 @@
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <ctime>
+#include <utility>
+#include <thread>
+#include <x86intrin.h>
+
+// Cycle-accurate wall clock built on rdtscp, extracted from the calibration
+// logic in rdtscp.cpp. Instead of a hardcoded CPU_FREQUENCY_GHZ, the clock
+// cross-calibrates against clock_gettime at startup and (optionally) keeps a
+// background thread correcting drift. now_ns() itself is just rdtscp plus a
+// 64x64->128 multiply with a precomputed fixed-point factor — no division
+// and no syscall on the hot path.
+class TscClock {
+public:
+    static TscClock& instance() {
+        static TscClock clock;
+        return clock;
+    }
+
+    // Nanoseconds since the monotonic epoch, derived from the cycle counter.
+    uint64_t now_ns() const {
+        // Anchor first, counter second: the anchor's base_tsc was sampled in
+        // the past, so a counter read taken afterwards can never precede it
+        // (the delta below stays non-negative even mid-recalibration).
+        const Anchor a = read_anchor();
+        unsigned aux;
+        const uint64_t tsc = __rdtscp(&aux);
+        return a.base_ns + cycles_to_ns(tsc - a.base_tsc, a.mult);
+    }
+
+    // Raw cycle count, for callers that only need deltas.
+    static uint64_t cycles() {
+        unsigned aux;
+        return __rdtscp(&aux);
+    }
+
+    // Convert a cycle delta to nanoseconds with the current calibration.
+    uint64_t to_ns(uint64_t cycle_delta) const {
+        return cycles_to_ns(cycle_delta, read_anchor().mult);
+    }
+
+    double frequency_ghz() const {
+        // mult is ns-per-cycle in 32.32 fixed point; GHz is its reciprocal.
+        return static_cast<double>(1ull << kFractionBits) /
+               static_cast<double>(read_anchor().mult);
+    }
+
+    // Re-measure the TSC frequency every `interval_ms` in a background
+    // thread. Each correction re-anchors base_ns/base_tsc so now_ns() stays
+    // continuous across multiplier updates.
+    void start_drift_correction(int interval_ms = 1000) {
+        bool expected = false;
+        if (!drift_running_.compare_exchange_strong(expected, true)) {
+            return; // Already running
+        }
+        drift_thread_ = std::thread([this, interval_ms] {
+            while (drift_running_.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+                recalibrate();
+            }
+        });
+    }
+
+    void stop_drift_correction() {
+        if (drift_running_.exchange(false) && drift_thread_.joinable()) {
+            drift_thread_.join();
+        }
+    }
+
+private:
+    static constexpr int kFractionBits = 32;
+
+    // Multiplier and epoch anchor travel together; a drift correction swaps
+    // all three fields under a seqlock (odd sequence = update in flight), so
+    // readers stay wait-free without a 24-byte atomic.
+    struct Anchor {
+        uint64_t mult;     // ns per cycle, 32.32 fixed point
+        uint64_t base_tsc;
+        uint64_t base_ns;
+    };
+
+    Anchor read_anchor() const {
+        for (;;) {
+            const uint32_t seq = anchor_seq_.load(std::memory_order_acquire);
+            if (seq & 1) {
+                continue; // Recalibration in flight
+            }
+            const Anchor a = anchor_;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (anchor_seq_.load(std::memory_order_relaxed) == seq) {
+                return a;
+            }
+        }
+    }
+
+    void write_anchor(const Anchor& a) {
+        anchor_seq_.fetch_add(1, std::memory_order_relaxed); // Now odd
+        std::atomic_thread_fence(std::memory_order_release);
+        anchor_ = a;
+        anchor_seq_.fetch_add(1, std::memory_order_release); // Even again
+    }
+
+    TscClock() {
+        const auto [tsc0, ns0] = sample();
+        // 10ms is enough for ~1ppm resolution against CLOCK_MONOTONIC.
+        struct timespec req = {0, 10 * 1000 * 1000};
+        nanosleep(&req, nullptr);
+        const auto [tsc1, ns1] = sample();
+
+        const uint64_t mult = compute_mult(tsc1 - tsc0, ns1 - ns0);
+        write_anchor({mult, tsc1, ns1});
+    }
+
+    ~TscClock() { stop_drift_correction(); }
+
+    static std::pair<uint64_t, uint64_t> sample() {
+        // Order rdtscp between two clock_gettime calls and use their midpoint
+        // so syscall latency cancels out of the pairing.
+        struct timespec before, after;
+        clock_gettime(CLOCK_MONOTONIC, &before);
+        unsigned aux;
+        const uint64_t tsc = __rdtscp(&aux);
+        clock_gettime(CLOCK_MONOTONIC, &after);
+        const uint64_t ns_before = static_cast<uint64_t>(before.tv_sec) * 1000000000ull + before.tv_nsec;
+        const uint64_t ns_after = static_cast<uint64_t>(after.tv_sec) * 1000000000ull + after.tv_nsec;
+        return {tsc, ns_before + (ns_after - ns_before) / 2};
+    }
+
+    static uint64_t compute_mult(uint64_t cycle_delta, uint64_t ns_delta) {
+        return static_cast<uint64_t>(
+            (static_cast<__uint128_t>(ns_delta) << kFractionBits) / cycle_delta);
+    }
+
+    static uint64_t cycles_to_ns(uint64_t cycle_delta, uint64_t mult) {
+        return static_cast<uint64_t>(
+            (static_cast<__uint128_t>(cycle_delta) * mult) >> kFractionBits);
+    }
+
+    void recalibrate() {
+        const Anchor old = read_anchor();
+        const auto [tsc, ns] = sample();
+        // Observed frequency since the last anchor, smoothed 9:1 against the
+        // current estimate the same way tick_every() adjusts its frequency.
+        const uint64_t observed = compute_mult(tsc - old.base_tsc, ns - old.base_ns);
+        const uint64_t smoothed = (old.mult / 10) * 9 + observed / 10;
+        // Re-anchor at the clock's own current reading so now_ns() never
+        // jumps backwards when the multiplier changes.
+        const uint64_t now = old.base_ns + cycles_to_ns(tsc - old.base_tsc, old.mult);
+        write_anchor({smoothed, tsc, now});
+    }
+
+    mutable std::atomic<uint32_t> anchor_seq_{0};
+    Anchor anchor_{};
+    std::atomic<bool> drift_running_{false};
+    std::thread drift_thread_;
+};
@@ -2,6 +2,7 @@
 #include <vector>
 #include <functional>
 #include <optional>
+#include <utility>
 
 template<typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>>
 class HashTable {
@@ -103,3 +104,636 @@ private:
         }
     }
 };
+
+// Robin Hood variant: linear probing where an inserting entry that has probed
+// further from its ideal slot than the resident entry steals the slot ("rich"
+// entries make way for "poor" ones). Removal backward-shifts the following
+// run instead of leaving a tombstone, so probe chains never accumulate holes
+// and lookups stay short even at 0.9 load factor.
+template<typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>>
+class RobinHoodHashTable {
+public:
+    RobinHoodHashTable(size_t initialSize = 8) : table(initialSize), size(0) {}
+
+    size_t getSize() const { return size; }
+    size_t getTableSize() const { return table.size(); }
+
+    void insert(const KeyType& key, const ValueType& value) {
+        if (loadFactor() >= 0.9) {
+            rehash();
+        }
+        insertEntry(Entry{key, value, 0});
+    }
+
+    std::optional<ValueType> find(const KeyType& key) const {
+        size_t index = hashFunction(key) % table.size();
+        size_t distance = 0;
+        while (table[index].has_value()) {
+            // An entry closer to its ideal slot than we have probed means the
+            // key cannot be further along the chain (Robin Hood invariant).
+            if (table[index]->distance < distance) {
+                return std::nullopt;
+            }
+            if (table[index]->key == key) {
+                return table[index]->value;
+            }
+            index = (index + 1) % table.size();
+            distance++;
+        }
+        return std::nullopt;
+    }
+
+    void remove(const KeyType& key) {
+        size_t index = hashFunction(key) % table.size();
+        size_t distance = 0;
+        while (table[index].has_value()) {
+            if (table[index]->distance < distance) {
+                return; // Not present
+            }
+            if (table[index]->key == key) {
+                backwardShift(index);
+                size--;
+                return;
+            }
+            index = (index + 1) % table.size();
+            distance++;
+        }
+    }
+
+private:
+    struct Entry {
+        KeyType key;
+        ValueType value;
+        size_t distance; // Probes from the ideal slot
+    };
+
+    std::vector<std::optional<Entry>> table;
+    size_t size;
+    Hash hashFunction;
+
+    double loadFactor() const {
+        return static_cast<double>(size) / table.size();
+    }
+
+    void insertEntry(Entry entry) {
+        size_t index = hashFunction(entry.key) % table.size();
+        entry.distance = 0;
+        while (table[index].has_value()) {
+            if (table[index]->key == entry.key) {
+                table[index]->value = std::move(entry.value);
+                return;
+            }
+            // Swap with a richer resident and keep probing for its new home.
+            if (table[index]->distance < entry.distance) {
+                std::swap(*table[index], entry);
+            }
+            index = (index + 1) % table.size();
+            entry.distance++;
+        }
+        table[index] = std::move(entry);
+        size++;
+    }
+
+    // Shift the probe run following `index` back by one slot; the run ends at
+    // an empty slot or an entry already sitting in its ideal position.
+    void backwardShift(size_t index) {
+        size_t next = (index + 1) % table.size();
+        while (table[next].has_value() && table[next]->distance > 0) {
+            table[index] = std::move(table[next]);
+            table[index]->distance--;
+            table[next] = std::nullopt;
+            index = next;
+            next = (next + 1) % table.size();
+        }
+        table[index] = std::nullopt;
+    }
+
+    void rehash() {
+        std::vector<std::optional<Entry>> oldTable(table.size() * 2);
+        std::swap(table, oldTable);
+        size = 0;
+        for (auto& entry : oldTable) {
+            if (entry.has_value()) {
+                insertEntry(std::move(*entry));
+            }
+        }
+    }
+};
+
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Swisstable-style layout: a flat byte array of control tags probed 16 at a
+// time with SSE2, and keys/values in separate contiguous arrays. A probe
+// touches one cache line of tags to reject 16 slots at once, instead of one
+// line per slot like the std::optional<pair> layout above.
+template<typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>>
+class FlatHashTable {
+public:
+    FlatHashTable(size_t initialSize = 16)
+        : capacity(groupAlign(initialSize)), control(capacity, kEmpty),
+          keys(capacity), values(capacity), size(0) {}
+
+    size_t getSize() const { return size; }
+    size_t getTableSize() const { return capacity; }
+
+    void insert(const KeyType& key, const ValueType& value) {
+        if (static_cast<double>(size + 1) / capacity >= 0.875) {
+            rehash();
+        }
+        const size_t hash = hashFunction(key);
+        const uint8_t tag = h2(hash);
+        size_t group = groupIndex(hash);
+        // The key may live past a deleted slot (it was displaced before the
+        // delete), so a vacancy alone does not prove absence. Probe until a
+        // group with an empty slot ends the chain, remembering the first
+        // deleted slot seen — that is where the key goes if it is absent.
+        size_t firstDeleted = capacity;
+        for (size_t probed = 0; probed < capacity; probed += kGroupSize) {
+            // First look for the key among slots sharing our 7-bit tag.
+            uint32_t matches = matchTag(&control[group], tag);
+            while (matches != 0) {
+                const size_t slot = group + lowestBit(matches);
+                if (keys[slot] == key) {
+                    values[slot] = value;
+                    return;
+                }
+                matches &= matches - 1;
+            }
+            if (firstDeleted == capacity) {
+                const uint32_t deleted = matchTag(&control[group], kDeleted);
+                if (deleted != 0) {
+                    firstDeleted = group + lowestBit(deleted);
+                }
+            }
+            // An empty slot ends the probe chain: the key is absent, so
+            // reuse the earliest tombstone or take the empty slot itself.
+            const uint32_t empty = matchEmpty(&control[group]);
+            if (empty != 0) {
+                const size_t slot = firstDeleted != capacity
+                        ? firstDeleted
+                        : group + lowestBit(empty);
+                control[slot] = tag;
+                keys[slot] = key;
+                values[slot] = value;
+                size++;
+                return;
+            }
+            group = (group + kGroupSize) & (capacity - 1);
+        }
+        // Every group was full-or-deleted; fall back to the first tombstone.
+        if (firstDeleted != capacity) {
+            control[firstDeleted] = tag;
+            keys[firstDeleted] = key;
+            values[firstDeleted] = value;
+            size++;
+        }
+    }
+
+    std::optional<ValueType> find(const KeyType& key) const {
+        const size_t hash = hashFunction(key);
+        const uint8_t tag = h2(hash);
+        size_t group = groupIndex(hash);
+        for (size_t probed = 0; probed < capacity; probed += kGroupSize) {
+            uint32_t matches = matchTag(&control[group], tag);
+            while (matches != 0) {
+                const size_t slot = group + lowestBit(matches);
+                if (keys[slot] == key) {
+                    return values[slot];
+                }
+                matches &= matches - 1;
+            }
+            // An empty slot in the group means the key was never displaced
+            // past it, so the probe sequence ends here.
+            if (matchEmpty(&control[group]) != 0) {
+                return std::nullopt;
+            }
+            group = (group + kGroupSize) & (capacity - 1);
+        }
+        return std::nullopt;
+    }
+
+    void remove(const KeyType& key) {
+        const size_t hash = hashFunction(key);
+        const uint8_t tag = h2(hash);
+        size_t group = groupIndex(hash);
+        for (size_t probed = 0; probed < capacity; probed += kGroupSize) {
+            uint32_t matches = matchTag(&control[group], tag);
+            while (matches != 0) {
+                const size_t slot = group + lowestBit(matches);
+                if (keys[slot] == key) {
+                    // Only mark deleted when the group ever overflowed;
+                    // otherwise the slot can go straight back to empty.
+                    control[slot] = matchEmpty(&control[group]) != 0 ? kEmpty : kDeleted;
+                    size--;
+                    return;
+                }
+                matches &= matches - 1;
+            }
+            if (matchEmpty(&control[group]) != 0) {
+                return;
+            }
+            group = (group + kGroupSize) & (capacity - 1);
+        }
+    }
+
+private:
+    static constexpr size_t kGroupSize = 16;
+    static constexpr uint8_t kEmpty = 0x80;
+    static constexpr uint8_t kDeleted = 0xFE;
+
+    size_t capacity;
+    std::vector<uint8_t> control;
+    std::vector<KeyType> keys;
+    std::vector<ValueType> values;
+    size_t size;
+    Hash hashFunction;
+
+    static size_t groupAlign(size_t n) {
+        size_t cap = kGroupSize;
+        while (cap < n) cap *= 2;
+        return cap;
+    }
+
+    // Low 7 bits of the hash become the control tag; the rest picks the group.
+    static uint8_t h2(size_t hash) { return static_cast<uint8_t>(hash & 0x7F); }
+    size_t groupIndex(size_t hash) const {
+        return ((hash >> 7) & (capacity - 1)) & ~(kGroupSize - 1);
+    }
+
+    static int lowestBit(uint32_t mask) { return __builtin_ctz(mask); }
+
+#if defined(__SSE2__)
+    static uint32_t matchTag(const uint8_t* group, uint8_t tag) {
+        const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(tag))));
+    }
+    static uint32_t matchEmpty(const uint8_t* group) { return matchTag(group, kEmpty); }
+#else
+    static uint32_t matchTag(const uint8_t* group, uint8_t tag) {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupSize; ++i) {
+            if (group[i] == tag) mask |= 1u << i;
+        }
+        return mask;
+    }
+    static uint32_t matchEmpty(const uint8_t* group) { return matchTag(group, kEmpty); }
+#endif
+
+    void rehash() {
+        std::vector<uint8_t> oldControl(capacity * 2, kEmpty);
+        std::vector<KeyType> oldKeys(capacity * 2);
+        std::vector<ValueType> oldValues(capacity * 2);
+        std::swap(control, oldControl);
+        std::swap(keys, oldKeys);
+        std::swap(values, oldValues);
+        capacity *= 2;
+        size = 0;
+        for (size_t i = 0; i < oldControl.size(); ++i) {
+            if ((oldControl[i] & 0x80) == 0) {
+                insert(oldKeys[i], oldValues[i]);
+            }
+        }
+    }
+};
+
+#include <atomic>
+#include <mutex>
+
+// Concurrent variant: hash-partitions across 2^ShardBits independent tables
+// so N threads contend only when they hit the same shard, instead of
+// serializing on one table-wide mutex. Each shard is cache-line aligned
+// (no false sharing between shard locks) and pairs a writer mutex with a
+// seqlock, so find() never takes a lock: readers copy the probe result
+// optimistically and retry if a writer's sequence bump shows the read raced.
+//
+// Seqlock reads may observe torn slots mid-write, so keys and values must be
+// trivially copyable — garbage is copied, detected via the sequence recheck,
+// and discarded. For the same reason shard storage is fixed at construction
+// (a rehash would free the buffer under a concurrent reader): size shards
+// for the expected key population and insert() reports exhaustion.
+template<typename KeyType, typename ValueType,
+         typename Hash = std::hash<KeyType>, size_t ShardBits = 4>
+class ShardedHashTable {
+    static_assert(std::is_trivially_copyable_v<KeyType> &&
+                  std::is_trivially_copyable_v<ValueType>,
+                  "Seqlock readers copy slots that writers may be mutating");
+
+public:
+    static constexpr size_t kNumShards = size_t(1) << ShardBits;
+
+    explicit ShardedHashTable(size_t capacityPerShard = 1024)
+        : shards_(kNumShards) {
+        size_t cap = 16;
+        while (cap < capacityPerShard) cap *= 2;
+        for (Shard& shard : shards_) {
+            shard.slots.resize(cap);
+        }
+    }
+
+    // Returns false when the key's shard is full (fixed storage, see above).
+    bool insert(const KeyType& key, const ValueType& value) {
+        const size_t hash = mix(hashFunction(key));
+        Shard& shard = shardFor(hash);
+        std::lock_guard<std::mutex> lock(shard.writeMutex);
+        WriteSection section(shard);
+        size_t index = hash & (shard.slots.size() - 1);
+        size_t firstVacant = shard.slots.size();
+        for (size_t probed = 0; probed < shard.slots.size(); ++probed) {
+            Slot& slot = shard.slots[index];
+            if (slot.state == Slot::kFull && slot.key == key) {
+                slot.value = value;
+                return true;
+            }
+            if (slot.state != Slot::kFull && firstVacant == shard.slots.size()) {
+                firstVacant = index;
+            }
+            if (slot.state == Slot::kEmpty) {
+                break; // Probe chain ends; key not present
+            }
+            index = (index + 1) & (shard.slots.size() - 1);
+        }
+        if (firstVacant == shard.slots.size() ||
+            shard.size + 1 > shard.slots.size() - shard.slots.size() / 8) {
+            return false; // Keep load under 0.875 so probes terminate quickly
+        }
+        Slot& slot = shard.slots[firstVacant];
+        slot.key = key;
+        slot.value = value;
+        slot.state = Slot::kFull;
+        shard.size++;
+        return true;
+    }
+
+    // Lock-free: retries only while a writer to the same shard is mid-update.
+    std::optional<ValueType> find(const KeyType& key) const {
+        const size_t hash = mix(hashFunction(key));
+        const Shard& shard = shardFor(hash);
+        for (;;) {
+            const uint64_t before = shard.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue; // Writer in progress; its unlock bumps to even
+            }
+            std::optional<ValueType> result = probe(shard, key, hash);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (shard.sequence.load(std::memory_order_relaxed) == before) {
+                return result;
+            }
+        }
+    }
+
+    void remove(const KeyType& key) {
+        const size_t hash = mix(hashFunction(key));
+        Shard& shard = shardFor(hash);
+        std::lock_guard<std::mutex> lock(shard.writeMutex);
+        WriteSection section(shard);
+        size_t index = hash & (shard.slots.size() - 1);
+        for (size_t probed = 0; probed < shard.slots.size(); ++probed) {
+            Slot& slot = shard.slots[index];
+            if (slot.state == Slot::kEmpty) {
+                return;
+            }
+            if (slot.state == Slot::kFull && slot.key == key) {
+                slot.state = Slot::kTombstone; // Keeps probe chains intact
+                shard.size--;
+                return;
+            }
+            index = (index + 1) & (shard.slots.size() - 1);
+        }
+    }
+
+    size_t getSize() const {
+        size_t total = 0;
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.writeMutex);
+            total += shard.size;
+        }
+        return total;
+    }
+
+    size_t getTableSize() const {
+        return shards_[0].slots.size() * kNumShards;
+    }
+
+private:
+    struct Slot {
+        static constexpr uint8_t kEmpty = 0;
+        static constexpr uint8_t kFull = 1;
+        static constexpr uint8_t kTombstone = 2;
+        uint8_t state = kEmpty;
+        KeyType key;
+        ValueType value;
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> sequence{0};
+        mutable std::mutex writeMutex;
+        std::vector<Slot> slots;
+        size_t size = 0;
+    };
+
+    // Seqlock write section: odd sequence while mutating, even when stable.
+    // The release fence orders the odd store before the slot writes; the
+    // final release store orders the slot writes before the even sequence.
+    struct WriteSection {
+        explicit WriteSection(Shard& shard) : shard_(shard) {
+            shard_.sequence.store(shard_.sequence.load(std::memory_order_relaxed) + 1,
+                                  std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        ~WriteSection() {
+            shard_.sequence.store(shard_.sequence.load(std::memory_order_relaxed) + 1,
+                                  std::memory_order_release);
+        }
+        Shard& shard_;
+    };
+
+    // std::hash<int> is the identity, which would park every small key in
+    // shard 0 and slot `key`; one multiplicative round spreads the bits so
+    // the top bits (shard) and bottom bits (slot) both vary.
+    static size_t mix(size_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+        return hash;
+    }
+
+    static size_t shardIndex(size_t hash) {
+        if constexpr (ShardBits == 0) {
+            return 0;
+        } else {
+            return hash >> (sizeof(size_t) * 8 - ShardBits);
+        }
+    }
+    Shard& shardFor(size_t hash) { return shards_[shardIndex(hash)]; }
+    const Shard& shardFor(size_t hash) const { return shards_[shardIndex(hash)]; }
+
+    // Plain (non-atomic) slot reads; only valid inside the seqlock protocol.
+    std::optional<ValueType> probe(const Shard& shard, const KeyType& key,
+                                   size_t hash) const {
+        size_t index = hash & (shard.slots.size() - 1);
+        for (size_t probed = 0; probed < shard.slots.size(); ++probed) {
+            const Slot& slot = shard.slots[index];
+            if (slot.state == Slot::kEmpty) {
+                return std::nullopt;
+            }
+            if (slot.state == Slot::kFull && slot.key == key) {
+                return slot.value;
+            }
+            index = (index + 1) & (shard.slots.size() - 1);
+        }
+        return std::nullopt;
+    }
+
+    std::vector<Shard> shards_;
+    Hash hashFunction;
+};
+
+// Incremental-resize variant: rehash() above reinserts every element in one
+// shot, so a table holding millions of entries stalls for as long as the
+// full migration takes the moment one insert crosses the load threshold.
+// Here a resize only allocates the new table; every subsequent operation
+// migrates a bounded run of old-table slots, so worst-case per-op latency is
+// O(kMigrateBatch) regardless of table size. Lookups consult both tables
+// until the old one drains. find() is non-const because it, too, pays a
+// migration quantum — total work is the same, just spread evenly.
+//
+// Sizing guarantee: the new table is twice the old, and a migration quantum
+// runs per operation, so the old table (at most 0.75 full) drains after
+// oldCapacity/kMigrateBatch ops — far before the inserts arriving in that
+// window can push the new table back to the 0.75 trigger.
+template<typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>>
+class IncrementalHashTable {
+public:
+    static constexpr size_t kMigrateBatch = 32; // Old-table slots scanned per op
+
+    IncrementalHashTable(size_t initialSize = 8) : table(initialSize) {}
+
+    size_t getSize() const { return size; }
+    size_t getTableSize() const { return table.size(); }
+    bool isMigrating() const { return !old.empty(); }
+
+    void insert(const KeyType& key, const ValueType& value) {
+        migrateSome();
+        if (!isMigrating() &&
+            static_cast<double>(size + tombstones + 1) / table.size() >= 0.75) {
+            // The expensive part of the old rehash() was the reinsert loop,
+            // not the allocation; start the migration and let it trickle.
+            old = std::move(table);
+            table.assign(old.size() * 2, Slot{});
+            migrateIndex = 0;
+            tombstones = 0;
+        }
+        if (overwriteIfPresent(table, key, value)) {
+            return;
+        }
+        if (isMigrating() && overwriteIfPresent(old, key, value)) {
+            return; // Will reach the new table when its slot migrates
+        }
+        size_t index = hashFunction(key) % table.size();
+        while (table[index].state == Slot::kFull) {
+            index = (index + 1) % table.size();
+        }
+        table[index] = Slot{Slot::kFull, key, value};
+        size++;
+    }
+
+    std::optional<ValueType> find(const KeyType& key) {
+        migrateSome();
+        if (const Slot* slot = probe(table, key)) {
+            return slot->value;
+        }
+        if (isMigrating()) {
+            if (const Slot* slot = probe(old, key)) {
+                return slot->value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void remove(const KeyType& key) {
+        migrateSome();
+        if (Slot* slot = probe(table, key)) {
+            slot->state = Slot::kTombstone; // Probe chains stay intact
+            size--;
+            tombstones++;
+            return;
+        }
+        if (isMigrating()) {
+            if (Slot* slot = probe(old, key)) {
+                slot->state = Slot::kTombstone;
+                size--;
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        static constexpr uint8_t kEmpty = 0;
+        static constexpr uint8_t kFull = 1;
+        static constexpr uint8_t kTombstone = 2;
+        uint8_t state = kEmpty;
+        KeyType key{};
+        ValueType value{};
+    };
+
+    std::vector<Slot> table; // Current table; resize target during migration
+    std::vector<Slot> old;   // Drained kMigrateBatch slots at a time
+    size_t migrateIndex = 0;
+    size_t size = 0;
+    size_t tombstones = 0; // In `table` only; count toward the load trigger
+    Hash hashFunction;
+
+    // Move up to kMigrateBatch old-table slots into the new table. Bounded
+    // by slots scanned, not entries moved, so every call is O(kMigrateBatch)
+    // even through empty runs.
+    void migrateSome() {
+        if (!isMigrating()) {
+            return;
+        }
+        const size_t stop = std::min(migrateIndex + kMigrateBatch, old.size());
+        for (; migrateIndex < stop; ++migrateIndex) {
+            Slot& slot = old[migrateIndex];
+            if (slot.state != Slot::kFull) {
+                continue;
+            }
+            size_t index = hashFunction(slot.key) % table.size();
+            while (table[index].state == Slot::kFull) {
+                index = (index + 1) % table.size();
+            }
+            table[index] = std::move(slot);
+            // Tombstone, not empty: old-table probe chains must stay intact
+            // for the keys still waiting behind this one.
+            slot.state = Slot::kTombstone;
+        }
+        if (migrateIndex == old.size()) {
+            old.clear();
+        }
+    }
+
+    Slot* probe(std::vector<Slot>& slots, const KeyType& key) {
+        size_t index = hashFunction(key) % slots.size();
+        while (slots[index].state != Slot::kEmpty) {
+            if (slots[index].state == Slot::kFull && slots[index].key == key) {
+                return &slots[index];
+            }
+            index = (index + 1) % slots.size();
+        }
+        return nullptr;
+    }
+    const Slot* probe(const std::vector<Slot>& slots, const KeyType& key) const {
+        return const_cast<IncrementalHashTable*>(this)->probe(
+            const_cast<std::vector<Slot>&>(slots), key);
+    }
+
+    bool overwriteIfPresent(std::vector<Slot>& slots, const KeyType& key,
+                            const ValueType& value) {
+        if (Slot* slot = probe(slots, key)) {
+            slot->value = value;
+            return true;
+        }
+        return false;
+    }
+};
@@ -1,4 +1,9 @@
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <span>
+#include <type_traits>
+#include <cstring>
 #include <vector>
 #include <stdexcept>
 #include <optional>
@@ -7,52 +12,215 @@
 template<typename T>
 class LocklessRingBuffer {
 public:
-    explicit LocklessRingBuffer(size_t size) : size_(size + 1), buffer_(size + 1), head_(0), tail_(0) {
-        if (size_ < 2) { // Adjusted to ensure at least one usable slot
+    explicit LocklessRingBuffer(size_t size)
+        : capacity_(size),
+          mask_(std::bit_ceil(size + 1) - 1),
+          buffer_(mask_ + 1),
+          head_(0),
+          tail_(0) {
+        if (size == 0 || size > (SIZE_MAX >> 2)) {
             throw std::invalid_argument("Size must be greater than 0");
         }
     }
 
     bool push(const T& item) {
         const size_t current_head = head_.load(std::memory_order_relaxed);
-        const size_t next_head = (current_head + 1) % size_;
 
-        // Check if the buffer is full
-        if (next_head == tail_.load(std::memory_order_acquire)) {
-            return false; // Buffer is full
+        // Only re-load the consumer index when the cached copy says we're full;
+        // in steady state the producer runs without touching the consumer's line.
+        if (current_head - cached_tail_ == capacity_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (current_head - cached_tail_ == capacity_) {
+                return false; // Buffer is full
+            }
         }
 
-        // Insert the item
-        buffer_[current_head] = item;
-        head_.store(next_head, std::memory_order_release);
+        // Insert the item (indices are monotonic; mask selects the slot)
+        buffer_[current_head & mask_] = item;
+        head_.store(current_head + 1, std::memory_order_release);
         return true; // Item successfully added
     }
 
     std::optional<T> pop() {
         const size_t current_tail = tail_.load(std::memory_order_relaxed);
 
-        // Check if the buffer is empty
-        if (current_tail == head_.load(std::memory_order_acquire)) {
-            return std::nullopt; // Buffer is empty
+        // Same trick on the consumer side: only reload head_ when we look empty.
+        if (current_tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (current_tail == cached_head_) {
+                return std::nullopt; // Buffer is empty
+            }
         }
 
         // Remove the item
-        T item = buffer_[current_tail];
-        tail_.store((current_tail + 1) % size_, std::memory_order_release);
+        T item = buffer_[current_tail & mask_];
+        tail_.store(current_tail + 1, std::memory_order_release);
         return item; // Return the popped item
     }
 
+    // Push as many items from `items` as fit, with one acquire-load and one
+    // release-store for the whole batch. Returns the number pushed.
+    size_t push_n(std::span<const T> items) {
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+
+        size_t free_slots = capacity_ - (current_head - cached_tail_);
+        if (free_slots < items.size()) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            free_slots = capacity_ - (current_head - cached_tail_);
+        }
+        const size_t count = std::min(items.size(), free_slots);
+        if (count == 0) {
+            return 0;
+        }
+
+        copy_in(current_head, items.data(), count);
+        head_.store(current_head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Pop up to `max` items into `out`; one acquire-load and one release-store
+    // regardless of how many items move. Returns the number popped.
+    size_t pop_n(T* out, size_t max) {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+
+        size_t available = cached_head_ - current_tail;
+        if (available < max) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            available = cached_head_ - current_tail;
+        }
+        const size_t count = std::min(max, available);
+        if (count == 0) {
+            return 0;
+        }
+
+        copy_out(current_tail, out, count);
+        tail_.store(current_tail + count, std::memory_order_release);
+        return count;
+    }
+
     bool is_empty() const {
         return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
     }
 
     bool is_full() const {
-        return (head_.load(std::memory_order_acquire) + 1) % size_ == tail_.load(std::memory_order_acquire);
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire) == capacity_;
     }
 
 private:
+    // Copy `count` items into the ring starting at logical index `start`,
+    // splitting the wraparound into at most two contiguous copies.
+    void copy_in(size_t start, const T* src, size_t count) {
+        const size_t slot = start & mask_;
+        const size_t first = std::min(count, buffer_.size() - slot);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(buffer_.data() + slot, src, first * sizeof(T));
+            std::memcpy(buffer_.data(), src + first, (count - first) * sizeof(T));
+        } else {
+            std::copy(src, src + first, buffer_.begin() + slot);
+            std::copy(src + first, src + count, buffer_.begin());
+        }
+    }
+
+    void copy_out(size_t start, T* dst, size_t count) {
+        const size_t slot = start & mask_;
+        const size_t first = std::min(count, buffer_.size() - slot);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(dst, buffer_.data() + slot, first * sizeof(T));
+            std::memcpy(dst + first, buffer_.data(), (count - first) * sizeof(T));
+        } else {
+            std::copy(buffer_.begin() + slot, buffer_.begin() + slot + first, dst);
+            std::copy(buffer_.begin(), buffer_.begin() + (count - first), dst + first);
+        }
+    }
+
+    const size_t capacity_; // Usable slots, as requested by the caller
+    const size_t mask_;     // Storage is the next power of two, so % becomes &
     std::vector<T> buffer_;
-    const size_t size_;
-    std::atomic<size_t> head_;
-    std::atomic<size_t> tail_;
+
+    // Producer and consumer indices live on separate cache lines so the
+    // producer's store never invalidates the consumer's line (and vice versa).
+    // Each side also keeps a cached copy of the opposing index next to its own.
+    alignas(64) std::atomic<size_t> head_;
+    size_t cached_tail_{0}; // Producer-only
+    alignas(64) std::atomic<size_t> tail_;
+    size_t cached_head_{0}; // Consumer-only
+};
+
+// MPMC variant (Vyukov bounded queue): each slot carries its own sequence
+// number, so producers claim slots with one fetch_add on the enqueue index
+// and consumers likewise on the dequeue index — no shared CAS retry loop and
+// no mutex wrapper needed when several feed threads share one buffer. The
+// slot sequence tells each side whether the cell is ready for it:
+//   seq == pos        -> empty, a producer may fill it
+//   seq == pos + 1    -> full, a consumer may drain it
+template<typename T>
+class MpmcRingBuffer {
+public:
+    explicit MpmcRingBuffer(size_t size)
+        : mask_(std::bit_ceil(size) - 1), slots_(mask_ + 1), head_(0), tail_(0) {
+        if (size == 0 || size > (SIZE_MAX >> 2)) {
+            throw std::invalid_argument("Size must be greater than 0");
+        }
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(const T& item) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                // Slot is free at our position; claim it.
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = item;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // CAS failure reloaded pos; retry with the new position.
+            } else if (diff < 0) {
+                return false; // Full: the slot still holds an unconsumed value
+            } else {
+                pos = head_.load(std::memory_order_relaxed); // Lost the race
+            }
+        }
+    }
+
+    std::optional<T> pop() {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    T item = slot.value;
+                    // Mark the slot free for the producer one lap ahead.
+                    slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return item;
+                }
+            } else if (diff < 0) {
+                return std::nullopt; // Empty: no producer has filled this slot yet
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool is_empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t mask_;
+    std::vector<Slot> slots_;
+    alignas(64) std::atomic<size_t> head_; // Next position to produce into
+    alignas(64) std::atomic<size_t> tail_; // Next position to consume from
 };
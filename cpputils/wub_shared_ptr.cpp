@@ -6,22 +6,32 @@ template<typename T>
 class SharedPtr {
 public:
     // Constructor
-    explicit SharedPtr(T* ptr = nullptr) 
+    explicit SharedPtr(T* ptr = nullptr)
         : ptr_(ptr), ref_count_(ptr ? new std::atomic<int>(1) : nullptr) {}
 
+    // Pool-aware constructor: adopts refcount storage owned by the caller
+    // (e.g. a slab slot, see slab_pool.cpp) and a deleter to run in place
+    // of `delete`. The deleter is responsible for the count storage too,
+    // so the last release touches the heap zero times.
+    SharedPtr(T* ptr, std::atomic<int>* ref_count, void (*deleter)(T*)) noexcept
+        : ptr_(ptr), ref_count_(ref_count), deleter_(deleter) {
+        ref_count_->store(1, std::memory_order_relaxed);
+    }
+
     // Copy constructor
-    SharedPtr(const SharedPtr& other) noexcept 
-        : ptr_(other.ptr_), ref_count_(other.ref_count_) {
+    SharedPtr(const SharedPtr& other) noexcept
+        : ptr_(other.ptr_), ref_count_(other.ref_count_), deleter_(other.deleter_) {
         if (ref_count_) {
             ref_count_->fetch_add(1, std::memory_order_relaxed); // Atomic increment
         }
     }
 
     // Move constructor
-    SharedPtr(SharedPtr&& other) noexcept 
-        : ptr_(other.ptr_), ref_count_(other.ref_count_) {
+    SharedPtr(SharedPtr&& other) noexcept
+        : ptr_(other.ptr_), ref_count_(other.ref_count_), deleter_(other.deleter_) {
         other.ptr_ = nullptr;
         other.ref_count_ = nullptr;
+        other.deleter_ = nullptr;
     }
 
     // Copy assignment operator
@@ -31,6 +41,7 @@ public:
 
             ptr_ = other.ptr_;
             ref_count_ = other.ref_count_;
+            deleter_ = other.deleter_;
             if (ref_count_) {
                 ref_count_->fetch_add(1, std::memory_order_relaxed); // Atomic increment
             }
@@ -45,8 +56,10 @@ public:
 
             ptr_ = other.ptr_;
             ref_count_ = other.ref_count_;
+            deleter_ = other.deleter_;
             other.ptr_ = nullptr;
             other.ref_count_ = nullptr;
+            other.deleter_ = nullptr;
         }
         return *this;
     }
@@ -71,17 +84,23 @@ public:
     void release() {
         if (ref_count_) {
             if (ref_count_->fetch_sub(1, std::memory_order_acq_rel) == 1) { // Atomic decrement
-                delete ptr_;
-                delete ref_count_;
+                if (deleter_) {
+                    deleter_(ptr_); // Owns the count storage as well
+                } else {
+                    delete ptr_;
+                    delete ref_count_;
+                }
             }
         }
         ptr_ = nullptr;
         ref_count_ = nullptr;
+        deleter_ = nullptr;
     }
 
 private:
     T* ptr_;                      // Raw pointer to the managed object
     std::atomic<int>* ref_count_; // Atomic reference count pointer
+    void (*deleter_)(T*) = nullptr; // Replaces `delete` when set (pooled objects)
 };
 
 
@@ -91,4 +110,283 @@ SharedPtr<T> my_make_shared(Args&&... args) {
     T* ptr = new T(std::forward<Args>(args)...);
 
     return SharedPtr<T>(ptr);
-}
\ No newline at end of file
+}
+// Hazard-pointer read path: for read-mostly sharing, bumping ref_count_ on
+// every acquire means 20 readers ping-pong one cache line. A reader can
+// instead publish the raw pointer into a per-thread hazard slot — a plain
+// store to a line only it writes — and a writer retiring an object defers
+// deletion until no slot still references it.
+#include <array>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class HazardDomain {
+public:
+    static constexpr size_t kMaxSlots = 128;
+    static constexpr size_t kScanThreshold = 64; // Retired objects before a scan
+
+    struct Slot {
+        std::atomic<const void*> protected_ptr{nullptr};
+        std::atomic<bool> in_use{false};
+        char padding[64 - sizeof(protected_ptr) - sizeof(in_use)];
+    };
+
+    static HazardDomain& instance() {
+        static HazardDomain domain;
+        return domain;
+    }
+
+    // Up to this many HazardPtr guards may be live on one thread at once
+    // (nested guards, or several sources read in one scope). Each gets its
+    // own slot — handing every guard the same cached slot would let an
+    // inner guard overwrite the outer guard's published pointer, leaving
+    // the outer object unprotected against reclamation.
+    static constexpr size_t kSlotsPerThread = 4;
+
+    // Claim a free slot from the calling thread's block; the CAS scan that
+    // carves the block out of the global array runs once per thread, and
+    // acquire/release afterwards only toggles a thread-private free mask.
+    Slot* acquireSlot() {
+        ThreadSlots& mine = threadSlots();
+        for (size_t i = 0; i < kSlotsPerThread; ++i) {
+            if (!(mine.busy & (1u << i))) {
+                mine.busy |= 1u << i;
+                return mine.slots[i];
+            }
+        }
+        throw std::runtime_error(
+            "HazardDomain: more than kSlotsPerThread live guards on one thread");
+    }
+
+    // Return a slot to the calling thread's block (guard destruction).
+    void releaseSlot(Slot* slot) {
+        slot->protected_ptr.store(nullptr, std::memory_order_release);
+        ThreadSlots& mine = threadSlots();
+        for (size_t i = 0; i < kSlotsPerThread; ++i) {
+            if (mine.slots[i] == slot) {
+                mine.busy &= ~(1u << i);
+                return;
+            }
+        }
+    }
+
+    // Defer deletion of `ptr` until no hazard slot references it.
+    template<typename T>
+    void retire(T* ptr) {
+        std::lock_guard<std::mutex> lock(retiredMutex_);
+        retired_.push_back({ptr, [](void* p) { delete static_cast<T*>(p); }});
+        if (retired_.size() >= kScanThreshold) {
+            scanLocked();
+        }
+    }
+
+    // Reclaim everything no longer protected. Exposed so tests (and shutdown
+    // paths) can force a scan instead of waiting for the threshold.
+    void scan() {
+        std::lock_guard<std::mutex> lock(retiredMutex_);
+        scanLocked();
+    }
+
+private:
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    // A thread's block of hazard slots plus the mask of ones currently
+    // handed to live guards. The destructor hands the block back at thread
+    // exit so slots outlive short-lived threads' claims.
+    struct ThreadSlots {
+        explicit ThreadSlots(HazardDomain& domain) {
+            size_t claimed = 0;
+            for (auto& slot : domain.slots_) {
+                bool expected = false;
+                if (slot.in_use.compare_exchange_strong(expected, true)) {
+                    slots[claimed++] = &slot;
+                    if (claimed == kSlotsPerThread) {
+                        return;
+                    }
+                }
+            }
+            throw std::runtime_error("HazardDomain: out of hazard slots");
+        }
+        ~ThreadSlots() {
+            for (Slot* slot : slots) {
+                slot->protected_ptr.store(nullptr, std::memory_order_release);
+                slot->in_use.store(false, std::memory_order_release);
+            }
+        }
+
+        Slot* slots[kSlotsPerThread] = {};
+        uint32_t busy = 0;
+    };
+
+    ThreadSlots& threadSlots() {
+        thread_local ThreadSlots mine(*this);
+        return mine;
+    }
+
+    void scanLocked() {
+        std::vector<Retired> stillProtected;
+        for (const Retired& r : retired_) {
+            bool hazardous = false;
+            for (const auto& slot : slots_) {
+                if (slot.protected_ptr.load(std::memory_order_acquire) == r.ptr) {
+                    hazardous = true;
+                    break;
+                }
+            }
+            if (hazardous) {
+                stillProtected.push_back(r);
+            } else {
+                r.deleter(r.ptr);
+            }
+        }
+        retired_.swap(stillProtected);
+    }
+
+    std::array<Slot, kMaxSlots> slots_;
+    std::mutex retiredMutex_;
+    std::vector<Retired> retired_;
+};
+
+// RAII read guard: protects the pointer loaded from `src` for its lifetime.
+// Acquire is two loads and one store on a thread-private line — no shared
+// fetch_add. The producer side swaps the atomic source and calls
+// HazardDomain::retire() on the old object instead of deleting it.
+template<typename T>
+class HazardPtr {
+public:
+    explicit HazardPtr(const std::atomic<T*>& src)
+        : slot_(HazardDomain::instance().acquireSlot()) {
+        // Publish-then-verify: the store must be visible before we re-check
+        // that the source still points at the same object, otherwise a
+        // concurrent retire+scan could miss our protection.
+        T* ptr = src.load(std::memory_order_acquire);
+        for (;;) {
+            slot_->protected_ptr.store(ptr, std::memory_order_seq_cst);
+            T* recheck = src.load(std::memory_order_acquire);
+            if (recheck == ptr) {
+                break;
+            }
+            ptr = recheck;
+        }
+        ptr_ = ptr;
+    }
+
+    ~HazardPtr() {
+        HazardDomain::instance().releaseSlot(slot_);
+    }
+
+    HazardPtr(const HazardPtr&) = delete;
+    HazardPtr& operator=(const HazardPtr&) = delete;
+
+    T& operator*() const { return *ptr_; }
+    T* operator->() const { return ptr_; }
+    T* get() const { return ptr_; }
+
+private:
+    T* ptr_;
+    HazardDomain::Slot* slot_;
+};
+
+// Intrusive refcounting: SharedPtr(T*) makes two allocations (object +
+// control block) and dereference/refcount touch two cache lines. Deriving
+// the payload from IntrusiveRefCount embeds the counter in the object, so
+// make_intrusive<T>() is exactly one allocation and the count shares a line
+// with the first members of T.
+class IntrusiveRefCount {
+public:
+    IntrusiveRefCount() = default;
+
+    // The count belongs to the object identity, not its value: copies start
+    // fresh and assignment leaves both counts alone.
+    IntrusiveRefCount(const IntrusiveRefCount&) {}
+    IntrusiveRefCount& operator=(const IntrusiveRefCount&) { return *this; }
+
+    void addRef() const {
+        intrusive_ref_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Returns true when this release dropped the last reference.
+    bool releaseRef() const {
+        return intrusive_ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    int use_count() const {
+        return intrusive_ref_count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    mutable std::atomic<int> intrusive_ref_count_{0};
+};
+
+template<typename T>
+class IntrusiveSharedPtr {
+    static_assert(std::is_base_of_v<IntrusiveRefCount, T>,
+                  "T must derive from IntrusiveRefCount");
+
+public:
+    explicit IntrusiveSharedPtr(T* ptr = nullptr) : ptr_(ptr) {
+        if (ptr_) {
+            ptr_->addRef();
+        }
+    }
+
+    IntrusiveSharedPtr(const IntrusiveSharedPtr& other) noexcept : ptr_(other.ptr_) {
+        if (ptr_) {
+            ptr_->addRef();
+        }
+    }
+
+    IntrusiveSharedPtr(IntrusiveSharedPtr&& other) noexcept : ptr_(other.ptr_) {
+        other.ptr_ = nullptr;
+    }
+
+    IntrusiveSharedPtr& operator=(const IntrusiveSharedPtr& other) noexcept {
+        if (this != &other) {
+            release();
+            ptr_ = other.ptr_;
+            if (ptr_) {
+                ptr_->addRef();
+            }
+        }
+        return *this;
+    }
+
+    IntrusiveSharedPtr& operator=(IntrusiveSharedPtr&& other) noexcept {
+        if (this != &other) {
+            release();
+            ptr_ = other.ptr_;
+            other.ptr_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~IntrusiveSharedPtr() { release(); }
+
+    T& operator*() const { return *ptr_; }
+    T* operator->() const { return ptr_; }
+    T* get() const { return ptr_; }
+
+    bool unique() const { return ptr_ && ptr_->use_count() == 1; }
+    int use_count() const { return ptr_ ? ptr_->use_count() : 0; }
+
+    void release() {
+        if (ptr_ && ptr_->releaseRef()) {
+            delete ptr_;
+        }
+        ptr_ = nullptr;
+    }
+
+private:
+    T* ptr_;
+};
+
+// Combined-allocation factory: one `new` covers counter and payload, since
+// the counter lives inside T.
+template<typename T, typename... Args>
+IntrusiveSharedPtr<T> make_intrusive(Args&&... args) {
+    return IntrusiveSharedPtr<T>(new T(std::forward<Args>(args)...));
+}
@@ -1,26 +1,53 @@
+#include <cstddef>
 #include <iostream>
+#include <type_traits>
 #include <utility> // For std::exchange
 
+// Default deleters, mirroring std::default_delete: the single-object form
+// calls delete, the array form delete[]. Both are empty types, so deleter
+// storage below costs nothing for the common case.
 template<typename T>
+struct DefaultDelete {
+    void operator()(T* ptr) const { delete ptr; }
+};
+
+template<typename T>
+struct DefaultDelete<T[]> {
+    void operator()(T* ptr) const { delete[] ptr; }
+};
+
+// The deleter is stored with [[no_unique_address]] — the C++20 spelling of
+// the compressed pair std::unique_ptr uses internally. A stateless deleter
+// (DefaultDelete, a pool deleter holding no members) overlaps the pointer
+// and UniquePtr stays exactly sizeof(T*), so a message header carrying one
+// doesn't spill past its cache line; a stateful deleter is stored by value
+// next to the pointer as before.
+template<typename T, typename Deleter = DefaultDelete<T>>
 class UniquePtr {
 public:
     // Constructor
     explicit UniquePtr(T* ptr = nullptr) : ptr_(ptr) {}
 
+    // Constructor with a deleter instance (for stateful deleters)
+    UniquePtr(T* ptr, Deleter deleter) : ptr_(ptr), deleter_(std::move(deleter)) {}
+
     // Destructor
-    ~UniquePtr() { delete ptr_; }
+    ~UniquePtr() {
+        if (ptr_) {
+            deleter_(ptr_);
+        }
+    }
 
     // Move constructor
-    UniquePtr(UniquePtr&& other) noexcept : ptr_(other.ptr_) {
-        other.ptr_ = nullptr; // Transfer ownership
-    }
+    UniquePtr(UniquePtr&& other) noexcept
+        : ptr_(std::exchange(other.ptr_, nullptr)),
+          deleter_(std::move(other.deleter_)) {}
 
     // Move assignment operator
     UniquePtr& operator=(UniquePtr&& other) noexcept {
         if (this != &other) {
-            delete ptr_; // Clean up current resource
-            ptr_ = other.ptr_; // Transfer ownership
-            other.ptr_ = nullptr;
+            reset(other.release()); // Clean up current resource, take ownership
+            deleter_ = std::move(other.deleter_);
         }
         return *this;
     }
@@ -36,6 +63,10 @@ public:
     // Get raw pointer
     T* get() const { return ptr_; }
 
+    // Access the deleter
+    Deleter& get_deleter() { return deleter_; }
+    const Deleter& get_deleter() const { return deleter_; }
+
     // Release ownership of the pointer
     T* release() {
         return std::exchange(ptr_, nullptr); // Set ptr_ to nullptr and return the old value
@@ -43,11 +74,72 @@ public:
 
     // Reset the unique_ptr with a new pointer
     void reset(T* ptr = nullptr) {
-        delete ptr_; // Clean up existing resource
-        ptr_ = ptr;  // Assign new pointer
+        if (ptr_) {
+            deleter_(ptr_); // Clean up existing resource
+        }
+        ptr_ = ptr; // Assign new pointer
     }
 
 private:
     T* ptr_; // Raw pointer
+    [[no_unique_address]] Deleter deleter_{};
+};
+
+// Array specialization: owns a T[] and destroys it with delete[] (or the
+// supplied deleter). Element access is operator[]; the single-object
+// operator* / operator-> are deliberately absent, as with std::unique_ptr.
+template<typename T, typename Deleter>
+class UniquePtr<T[], Deleter> {
+public:
+    explicit UniquePtr(T* ptr = nullptr) : ptr_(ptr) {}
+
+    UniquePtr(T* ptr, Deleter deleter) : ptr_(ptr), deleter_(std::move(deleter)) {}
+
+    ~UniquePtr() {
+        if (ptr_) {
+            deleter_(ptr_);
+        }
+    }
+
+    UniquePtr(UniquePtr&& other) noexcept
+        : ptr_(std::exchange(other.ptr_, nullptr)),
+          deleter_(std::move(other.deleter_)) {}
+
+    UniquePtr& operator=(UniquePtr&& other) noexcept {
+        if (this != &other) {
+            reset(other.release());
+            deleter_ = std::move(other.deleter_);
+        }
+        return *this;
+    }
+
+    UniquePtr(const UniquePtr&) = delete;
+    UniquePtr& operator=(const UniquePtr&) = delete;
+
+    // Element access
+    T& operator[](size_t index) const { return ptr_[index]; }
+
+    T* get() const { return ptr_; }
+
+    Deleter& get_deleter() { return deleter_; }
+    const Deleter& get_deleter() const { return deleter_; }
+
+    T* release() {
+        return std::exchange(ptr_, nullptr);
+    }
+
+    void reset(T* ptr = nullptr) {
+        if (ptr_) {
+            deleter_(ptr_);
+        }
+        ptr_ = ptr;
+    }
+
+private:
+    T* ptr_;
+    [[no_unique_address]] Deleter deleter_{};
 };
 
+// With a stateless deleter the whole smart pointer is just the pointer.
+static_assert(sizeof(UniquePtr<int>) == sizeof(int*));
+static_assert(sizeof(UniquePtr<int[]>) == sizeof(int*));
@@ -3,6 +3,11 @@
 #include <unordered_map>
 #include <string>
 #include <stdexcept>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <barrier>
+#include <thread>
 
 // Base class for expressions
 class Expression {
@@ -26,37 +31,60 @@ public:
     }
 };
 
-// Class for variables
+// Class for variables. Names are interned to dense integer IDs once, at
+// construction: evaluate() and setVariableValue() then index flat vectors
+// instead of hashing the name — the string table is only touched when a new
+// name first appears.
 class Variable : public Expression {
     std::string name;
-    static std::unordered_map<std::string, int> variableMap;
+    int id; // Dense index into values/assigned, resolved at construction
+
+    static std::unordered_map<std::string, int> internTable;
+    static std::vector<int> values;
+    static std::vector<bool> assigned;
+
+    static int internName(const std::string& n) {
+        auto [it, inserted] = internTable.try_emplace(n, static_cast<int>(values.size()));
+        if (inserted) {
+            values.push_back(0);
+            assigned.push_back(false);
+        }
+        return it->second;
+    }
 
 public:
-    Variable(const std::string& n) : name(n) {}
+    Variable(const std::string& n) : name(n), id(internName(n)) {}
 
     std::string toString() const override {
         return name;
     }
     int evaluate() const override {
-        if (variableMap.find(name) == variableMap.end()) {
+        if (!assigned[id]) {
             throw std::runtime_error("Cannot evaluate a variable without a value.");
         }
-        return variableMap[name];
+        return values[id];
     }
 
     static void setVariableValue(const std::string& name, int value) {
-        variableMap[name] = value;
+        // One intern lookup per call site's name; the update itself is a store.
+        const int id = internName(name);
+        values[id] = value;
+        assigned[id] = true;
     }
     static void displayVariableMap() {
         std::cout << "Variable Map Contents:" << std::endl;
-        for (const auto& pair : variableMap) {
-            std::cout << "Variable: " << pair.first << ", Value: " << pair.second << std::endl;
+        for (const auto& pair : internTable) {
+            if (assigned[pair.second]) {
+                std::cout << "Variable: " << pair.first << ", Value: " << values[pair.second] << std::endl;
+            }
         }
     }
 };
 
-// Define static member
-std::unordered_map<std::string, int> Variable::variableMap;
+// Define static members
+std::unordered_map<std::string, int> Variable::internTable;
+std::vector<int> Variable::values;
+std::vector<bool> Variable::assigned;
 
 // Class for binary operations
 class BinaryOperation : public Expression {
@@ -123,6 +151,370 @@ std::shared_ptr<Expression> processBinaryOperation(std::shared_ptr<Expression> l
     return binOp; // Return the newly created binary operation
 }
 
+// Hash-consed arena: the allocation-free, string-free counterpart of the
+// shared_ptr/toString() machinery above. Every distinct node is interned
+// exactly once, keyed by (op, child IDs) rather than a rendered string, so
+// structural equality is an integer compare and building the DAG is O(n)
+// instead of O(n^2 * stringlen). Nodes live contiguously in creation order,
+// which also means children always precede parents — evaluation is a single
+// forward sweep over a flat array.
+class ExprArena {
+public:
+    using NodeId = uint32_t;
+    enum class Op : uint8_t { Constant, Variable, Add, Sub, Mul, Div };
+
+    struct Node {
+        Op op;
+        int value;    // Constant payload, or dense variable ID
+        NodeId left;  // Child IDs (unused for leaves)
+        NodeId right;
+    };
+
+    NodeId constant(int v) {
+        return intern(Node{Op::Constant, v, 0, 0});
+    }
+
+    NodeId variable(const std::string& name) {
+        auto [it, inserted] = varIds.emplace(name, static_cast<int>(varNames.size()));
+        if (inserted) {
+            varNames.push_back(name);
+        }
+        return intern(Node{Op::Variable, it->second, 0, 0});
+    }
+
+    NodeId binary(Op op, NodeId left, NodeId right) {
+        if ((op == Op::Add || op == Op::Mul) && left > right) {
+            std::swap(left, right); // Canonical operand order for commutative ops
+        }
+        return intern(Node{op, 0, left, right});
+    }
+
+    // Evaluate every node in one forward pass (children precede parents by
+    // construction); returns the value of `root`. `varValues` is indexed by
+    // the dense variable IDs handed out by variable().
+    int evaluate(NodeId root, const std::vector<int>& varValues) const {
+        std::vector<int> slots(root + 1);
+        for (NodeId id = 0; id <= root; ++id) {
+            const Node& n = nodes[id];
+            switch (n.op) {
+                case Op::Constant: slots[id] = n.value; break;
+                case Op::Variable: slots[id] = varValues.at(n.value); break;
+                case Op::Add: slots[id] = slots[n.left] + slots[n.right]; break;
+                case Op::Sub: slots[id] = slots[n.left] - slots[n.right]; break;
+                case Op::Mul: slots[id] = slots[n.left] * slots[n.right]; break;
+                case Op::Div: slots[id] = slots[n.left] / slots[n.right]; break;
+            }
+        }
+        return slots[root];
+    }
+
+    std::string toString(NodeId id) const {
+        const Node& n = nodes[id];
+        switch (n.op) {
+            case Op::Constant: return std::to_string(n.value);
+            case Op::Variable: return varNames[n.value];
+            default:
+                return "(" + toString(n.left) + " " + opName(n.op) + " " + toString(n.right) + ")";
+        }
+    }
+
+    size_t nodeCount() const { return nodes.size(); }
+    size_t variableCount() const { return varNames.size(); }
+    const Node& node(NodeId id) const { return nodes[id]; }
+
+private:
+    static const char* opName(Op op) {
+        switch (op) {
+            case Op::Add: return "+";
+            case Op::Sub: return "-";
+            case Op::Mul: return "*";
+            case Op::Div: return "/";
+            default: return "?";
+        }
+    }
+
+    // Full (op, value-or-left, right) interning key, compared field by
+    // field. An earlier revision packed the triple into one uint64 with
+    // 28-bit payload fields; a constant outside that range (or negative)
+    // spilled into neighbouring fields and silently aliased unrelated
+    // nodes, so the key now carries the fields verbatim — any int payload
+    // and the full NodeId range are valid.
+    struct InternKey {
+        uint8_t op;
+        uint32_t a;
+        uint32_t b;
+        bool operator==(const InternKey&) const = default;
+    };
+
+    struct InternKeyHash {
+        size_t operator()(const InternKey& k) const {
+            uint64_t h = (static_cast<uint64_t>(k.a) << 32) | k.b;
+            h ^= static_cast<uint64_t>(k.op) << 56;
+            // splitmix64 finalizer: dense sequential node IDs need mixing
+            // before they meet the hash table's bucket mask.
+            h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ull;
+            h ^= h >> 27; h *= 0x94d049bb133111ebull;
+            h ^= h >> 31;
+            return static_cast<size_t>(h);
+        }
+    };
+
+    static InternKey keyOf(const Node& n) {
+        const uint32_t a = (n.op == Op::Constant || n.op == Op::Variable)
+                               ? static_cast<uint32_t>(n.value)
+                               : n.left;
+        return InternKey{static_cast<uint8_t>(n.op), a, n.right};
+    }
+
+    NodeId intern(const Node& n) {
+        auto [it, inserted] = internMap.emplace(keyOf(n), static_cast<NodeId>(nodes.size()));
+        if (inserted) {
+            nodes.push_back(n);
+        }
+        return it->second;
+    }
+
+    std::vector<Node> nodes; // Contiguous arena, creation (= topological) order
+    std::unordered_map<InternKey, NodeId, InternKeyHash> internMap;
+    std::vector<std::string> varNames;
+    std::unordered_map<std::string, int> varIds;
+};
+
+// Bytecode compilation of an arena DAG: the (CSE-deduplicated) nodes
+// reachable from a root are flattened into a linear register program with
+// variables resolved to dense slot indices at compile time. Re-evaluating
+// the same DAG over many variable bindings then never touches the tree, the
+// virtual dispatch, or a name lookup — and runBatch keeps each instruction's
+// loop over the bindings contiguous so the compiler vectorizes it.
+class ExprProgram {
+public:
+    ExprProgram(const ExprArena& arena, ExprArena::NodeId root)
+        : numVariables(arena.variableCount()) {
+        compile(arena, root);
+    }
+
+    // Evaluate for one binding set (indexed by dense variable ID).
+    int run(const std::vector<int>& varValues) const {
+        std::vector<int> regs(instructions.size());
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            const Instr& in = instructions[i];
+            switch (in.op) {
+                case ExprArena::Op::Constant: regs[i] = in.a; break;
+                case ExprArena::Op::Variable: regs[i] = varValues[in.a]; break;
+                case ExprArena::Op::Add: regs[i] = regs[in.a] + regs[in.b]; break;
+                case ExprArena::Op::Sub: regs[i] = regs[in.a] - regs[in.b]; break;
+                case ExprArena::Op::Mul: regs[i] = regs[in.a] * regs[in.b]; break;
+                case ExprArena::Op::Div: regs[i] = regs[in.a] / regs[in.b]; break;
+            }
+        }
+        return regs.back();
+    }
+
+    // Batch evaluation: `columns[varId]` holds that variable's value for each
+    // of N bindings. One pass per instruction over contiguous arrays — the
+    // inner loops are branch-free and vectorize.
+    std::vector<int> runBatch(const std::vector<std::vector<int>>& columns) const {
+        const size_t n = columns.empty() ? 0 : columns[0].size();
+        std::vector<std::vector<int>> regs(instructions.size(), std::vector<int>(n));
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            const Instr& in = instructions[i];
+            int* dst = regs[i].data();
+            switch (in.op) {
+                case ExprArena::Op::Constant:
+                    for (size_t k = 0; k < n; ++k) dst[k] = in.a;
+                    break;
+                case ExprArena::Op::Variable: {
+                    const int* src = columns[in.a].data();
+                    for (size_t k = 0; k < n; ++k) dst[k] = src[k];
+                    break;
+                }
+                default: {
+                    const int* lhs = regs[in.a].data();
+                    const int* rhs = regs[in.b].data();
+                    switch (in.op) {
+                        case ExprArena::Op::Add:
+                            for (size_t k = 0; k < n; ++k) dst[k] = lhs[k] + rhs[k];
+                            break;
+                        case ExprArena::Op::Sub:
+                            for (size_t k = 0; k < n; ++k) dst[k] = lhs[k] - rhs[k];
+                            break;
+                        case ExprArena::Op::Mul:
+                            for (size_t k = 0; k < n; ++k) dst[k] = lhs[k] * rhs[k];
+                            break;
+                        default: // Div
+                            for (size_t k = 0; k < n; ++k) dst[k] = lhs[k] / rhs[k];
+                            break;
+                    }
+                }
+            }
+        }
+        return regs.back();
+    }
+
+    size_t instructionCount() const { return instructions.size(); }
+
+private:
+    struct Instr {
+        ExprArena::Op op;
+        int a; // Constant payload, variable slot, or lhs register
+        int b; // rhs register
+    };
+
+    // Emit only the nodes reachable from `root`, post-order, renumbering
+    // node IDs into dense register indices.
+    void compile(const ExprArena& arena, ExprArena::NodeId root) {
+        std::unordered_map<ExprArena::NodeId, int> regOf;
+        emit(arena, root, regOf);
+    }
+
+    int emit(const ExprArena& arena, ExprArena::NodeId id,
+             std::unordered_map<ExprArena::NodeId, int>& regOf) {
+        auto it = regOf.find(id);
+        if (it != regOf.end()) {
+            return it->second; // Shared subexpression: computed once
+        }
+        const auto& n = arena.node(id);
+        Instr instr{n.op, 0, 0};
+        if (n.op == ExprArena::Op::Constant || n.op == ExprArena::Op::Variable) {
+            instr.a = n.value;
+        } else {
+            instr.a = emit(arena, n.left, regOf);
+            instr.b = emit(arena, n.right, regOf);
+        }
+        const int reg = static_cast<int>(instructions.size());
+        instructions.push_back(instr);
+        regOf.emplace(id, reg);
+        return reg;
+    }
+
+    std::vector<Instr> instructions;
+    size_t numVariables;
+};
+
+// Dependency-levelized parallel evaluation of an arena DAG. After CSE the
+// DAG is wide: every node whose children sit at lower depths can evaluate
+// independently of its siblings. The constructor topologically levelizes
+// the nodes reachable from the root (level = 1 + max child level, a single
+// forward pass since arena order already puts children before parents) and
+// renumbers them into a dense, preallocated slot array. evaluate() then
+// runs level by level: worker threads split each level's nodes between
+// them and write results straight into their slots — no virtual calls, no
+// allocation, no locking; the only synchronization is one barrier per
+// level. With levels much wider than the thread count (a pricing DAG with
+// ~250-wide levels), the barrier cost amortizes to near-linear scaling.
+class LevelizedEvaluator {
+    using Op = ExprArena::Op;
+
+public:
+    LevelizedEvaluator(const ExprArena& arena, ExprArena::NodeId root,
+                       unsigned threadCount = std::thread::hardware_concurrency())
+        : threadCount(std::max(1u, threadCount)) {
+        // Mark the nodes reachable from the root; the arena may hold other
+        // expressions.
+        std::vector<char> reachable(root + 1, 0);
+        std::vector<ExprArena::NodeId> stack{root};
+        reachable[root] = 1;
+        while (!stack.empty()) {
+            const ExprArena::NodeId id = stack.back();
+            stack.pop_back();
+            const auto& n = arena.node(id);
+            if (n.op != Op::Constant && n.op != Op::Variable) {
+                for (ExprArena::NodeId child : {n.left, n.right}) {
+                    if (!reachable[child]) {
+                        reachable[child] = 1;
+                        stack.push_back(child);
+                    }
+                }
+            }
+        }
+
+        // Dense renumbering + levelization in one forward sweep.
+        std::vector<int> denseOf(root + 1, -1);
+        std::vector<int> levelOf;
+        for (ExprArena::NodeId id = 0; id <= root; ++id) {
+            if (!reachable[id]) continue;
+            const auto& n = arena.node(id);
+            Node node{n.op, n.value, 0, 0};
+            int level = 0;
+            if (n.op != Op::Constant && n.op != Op::Variable) {
+                node.left = denseOf[n.left];
+                node.right = denseOf[n.right];
+                level = 1 + std::max(levelOf[node.left], levelOf[node.right]);
+            }
+            denseOf[id] = static_cast<int>(nodes.size());
+            levelOf.push_back(level);
+            if (static_cast<size_t>(level) >= levels.size()) {
+                levels.emplace_back();
+            }
+            levels[level].push_back(static_cast<int>(nodes.size()));
+            nodes.push_back(node);
+        }
+        rootSlot = denseOf[root];
+        slots.resize(nodes.size());
+    }
+
+    // Evaluates the DAG for one variable binding. Threads stride each
+    // level's node list between them and meet at a barrier before the next
+    // level, so a node never runs before its children have written their
+    // slots.
+    int evaluate(const std::vector<int>& varValues) {
+        std::barrier levelDone(threadCount);
+        auto worker = [&](unsigned tid) {
+            for (const std::vector<int>& level : levels) {
+                for (size_t i = tid; i < level.size(); i += threadCount) {
+                    evalNode(level[i], varValues);
+                }
+                levelDone.arrive_and_wait();
+            }
+        };
+
+        std::vector<std::thread> team;
+        for (unsigned tid = 1; tid < threadCount; ++tid) {
+            team.emplace_back(worker, tid);
+        }
+        worker(0); // This thread is part of the team
+        for (auto& t : team) {
+            t.join();
+        }
+        return slots[rootSlot];
+    }
+
+    size_t levelCount() const { return levels.size(); }
+    size_t maxLevelWidth() const {
+        size_t width = 0;
+        for (const auto& level : levels) {
+            width = std::max(width, level.size());
+        }
+        return width;
+    }
+
+private:
+    struct Node {
+        Op op;
+        int value; // Constant payload or dense variable ID
+        int left;  // Dense slot indices of the children
+        int right;
+    };
+
+    void evalNode(int slot, const std::vector<int>& varValues) {
+        const Node& n = nodes[slot];
+        switch (n.op) {
+            case Op::Constant: slots[slot] = n.value; break;
+            case Op::Variable: slots[slot] = varValues[n.value]; break;
+            case Op::Add: slots[slot] = slots[n.left] + slots[n.right]; break;
+            case Op::Sub: slots[slot] = slots[n.left] - slots[n.right]; break;
+            case Op::Mul: slots[slot] = slots[n.left] * slots[n.right]; break;
+            case Op::Div: slots[slot] = slots[n.left] / slots[n.right]; break;
+        }
+    }
+
+    unsigned threadCount;
+    std::vector<Node> nodes;             // Dense, children before parents
+    std::vector<std::vector<int>> levels; // Slot indices grouped by depth
+    std::vector<int> slots;              // Preallocated results, reused per run
+    int rootSlot = 0;
+};
+
 int main() {
     // Define variables and constants
     Variable::setVariableValue("a", 5);
@@ -143,5 +535,58 @@ int main() {
     displayValueNumberMap();
     Variable::displayVariableMap();
 
+    // Same computation through the hash-consed arena: b and the two uses of
+    // b * 2 intern to single nodes, compared by ID, no strings involved.
+    ExprArena arena;
+    auto va = arena.variable("a");
+    auto vb = arena.binary(ExprArena::Op::Add, va, arena.constant(10));
+    auto vd = arena.binary(ExprArena::Op::Mul, vb, arena.constant(2));
+    auto ve = arena.binary(ExprArena::Op::Mul, vb, arena.constant(2));
+    std::cout << "Arena: " << arena.toString(vd) << " = "
+              << arena.evaluate(vd, {5})
+              << " (d and e share node: " << std::boolalpha << (vd == ve)
+              << ", " << arena.nodeCount() << " nodes total)" << std::endl;
+
+    // Compile the DAG once, then evaluate it over a batch of bindings with
+    // no tree walk and no per-evaluation variable lookup.
+    ExprProgram program(arena, vd);
+    std::vector<std::vector<int>> bindings = {{5, 6, 7, 8}}; // Column for "a"
+    auto results = program.runBatch(bindings);
+    std::cout << "Compiled to " << program.instructionCount()
+              << " instructions; batch results:";
+    for (int r : results) std::cout << " " << r;
+    std::cout << std::endl;
+
+    // Levelized parallel evaluation on a wide DAG: 64 leaves reduced
+    // pairwise with alternating ops, with every intermediate also feeding a
+    // second parent so the interior stays shared (CSE keeps each node
+    // unique). Each reduction layer is one independent level.
+    ExprArena wide;
+    std::vector<ExprArena::NodeId> layer;
+    for (int i = 0; i < 64; ++i) {
+        layer.push_back(i % 2 == 0 ? wide.variable("x" + std::to_string(i / 2))
+                                   : wide.constant(i));
+    }
+    while (layer.size() > 1) {
+        std::vector<ExprArena::NodeId> next;
+        for (size_t i = 0; i + 1 < layer.size(); i += 2) {
+            const auto op = (i / 2) % 2 == 0 ? ExprArena::Op::Add : ExprArena::Op::Mul;
+            next.push_back(wide.binary(op, layer[i], layer[i + 1]));
+        }
+        layer = std::move(next);
+    }
+    const auto wideRoot = layer.front();
+
+    std::vector<int> xs(wide.variableCount());
+    for (size_t i = 0; i < xs.size(); ++i) xs[i] = static_cast<int>(i) + 1;
+
+    LevelizedEvaluator evaluator(wide, wideRoot, 4);
+    const int parallel = evaluator.evaluate(xs);
+    const int serial = wide.evaluate(wideRoot, xs);
+    std::cout << "Levelized: " << evaluator.levelCount() << " levels, max width "
+              << evaluator.maxLevelWidth() << "; parallel=" << parallel
+              << " serial=" << serial
+              << (parallel == serial ? " (match)" : " (MISMATCH)") << std::endl;
+
     return 0;
 }
\ No newline at end of file
@@ -1,3 +1,3 @@
 #!/bin/bash
  # g++ -I$CONDA_PREFIX/include -L$CONDA_PREFIX/lib cse.cpp -lsymengine -lflint -o cse && ./cse
- g++ cse.cpp -o cse && ./cse
\ No newline at end of file
+ g++ -std=c++20 -O2 cse.cpp -o cse -lpthread && ./cse
\ No newline at end of file
@@ -1,16 +1,149 @@
 #include <iostream>
 #include <cstring>
+#include <string_view>
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <cerrno>
+#include <emmintrin.h> // _mm_pause
 
 const char* MULTICAST_ADDR = "239.0.0.1";
+const char* MULTICAST_ADDR_B = "239.0.0.2"; // Redundant B line (see server.cpp)
 const int PORT = 12345;
 
-int main() {
+// SO_PREFER_BUSY_POLL appeared in linux 5.11; define for older sysroots.
+#ifndef SO_PREFER_BUSY_POLL
+#define SO_PREFER_BUSY_POLL 69
+#endif
+
+// Low-latency receive configuration: a blocking recv costs a wakeup from the
+// scheduler (~30us on our boxes); busy-polling the NIC from a spinning
+// non-blocking socket avoids that entirely. The same binary keeps the plain
+// blocking path for lab use — pass --lowlat to enable the spin mode.
+struct LowLatencyConfig {
+    int busyPollMicros = 50;       // SO_BUSY_POLL: poll the driver this long
+    int rcvbufBytes = 8 * 1024 * 1024; // Large SO_RCVBUF absorbs bursts
+};
+
+static bool configure_low_latency(int sockfd, const LowLatencyConfig& cfg) {
+    // Non-blocking: the receive loop spins in userspace instead of sleeping.
+    const int flags = fcntl(sockfd, F_GETFL, 0);
+    if (fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        perror("fcntl O_NONBLOCK failed");
+        return false;
+    }
+
+    if (setsockopt(sockfd, SOL_SOCKET, SO_RCVBUF, &cfg.rcvbufBytes,
+                   sizeof(cfg.rcvbufBytes)) < 0) {
+        perror("setsockopt SO_RCVBUF failed");
+        return false;
+    }
+
+    // Busy-poll the device queue from recv() instead of arming interrupts.
+    // Not every kernel/NIC supports these; warn and continue.
+    if (setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL, &cfg.busyPollMicros,
+                   sizeof(cfg.busyPollMicros)) < 0) {
+        perror("setsockopt SO_BUSY_POLL (continuing without)");
+    }
+    const int prefer = 1;
+    if (setsockopt(sockfd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer,
+                   sizeof(prefer)) < 0) {
+        perror("setsockopt SO_PREFER_BUSY_POLL (continuing without)");
+    }
+    return true;
+}
+
+// Pre-registered buffer pool for the spin loop: packets are exposed as views
+// into these slots, so the hot path never allocates or copies. A slot is
+// reused only after the application has consumed the previous view.
+class PacketBufferPool {
+public:
+    static constexpr size_t kSlots = 64;
+    static constexpr size_t kSlotSize = 2048;
+
+    char* nextSlot() { return buffers[cursor++ % kSlots]; }
+
+private:
+    char buffers[kSlots][kSlotSize];
+    size_t cursor = 0;
+};
+
+// A/B line arbitration: the server publishes every datagram with a 64-bit
+// sequence header on two multicast groups. The arbiter delivers the first
+// copy of each sequence to arrive on either line and suppresses the other
+// via a sliding window of recently seen sequences. Either line can hiccup
+// independently; arbitrating across both is the cheapest p99 win available.
+class FeedArbiter {
+public:
+    using DeliverFn = void (*)(uint64_t seq, std::string_view payload);
+    using GapFn = void (*)(uint64_t fromSeq, uint64_t toSeq);
+
+    FeedArbiter(DeliverFn deliver, GapFn onGap) : deliver(deliver), onGap(onGap) {}
+
+    // Feed a raw datagram from either line. Returns true if it carried a
+    // not-yet-seen sequence and was delivered.
+    bool onPacket(const char* data, size_t len) {
+        if (len < sizeof(uint64_t)) {
+            return false; // Malformed: no header
+        }
+        uint64_t seq_be;
+        std::memcpy(&seq_be, data, sizeof(seq_be));
+        const uint64_t seq = ntohll(seq_be);
+        const std::string_view payload(data + sizeof(seq_be), len - sizeof(seq_be));
+
+        if (nextExpected == 0) {
+            // Late join: we have no idea what came before; start the window
+            // here and let the recovery hook ask for history if it wants it.
+            nextExpected = seq;
+        }
+
+        if (seq < nextExpected || isSeen(seq)) {
+            return false; // Duplicate from the other line (or ancient)
+        }
+
+        if (seq > nextExpected) {
+            // One line is ahead: everything in between is (so far) missing.
+            // The gap hook is where a real deployment requests retransmission.
+            onGap(nextExpected, seq);
+        }
+
+        markSeen(seq);
+        deliver(seq, payload);
+
+        // Advance past any contiguous run of delivered sequences.
+        while (isSeen(nextExpected)) {
+            clearSeen(nextExpected);
+            ++nextExpected;
+        }
+        return true;
+    }
+
+private:
+    // Sequence window: one bit per in-flight sequence, sized to cover the
+    // worst inter-line skew we have observed (with margin).
+    static constexpr uint64_t kWindow = 1024;
+
+    static uint64_t ntohll(uint64_t v) {
+        return (static_cast<uint64_t>(ntohl(v & 0xFFFFFFFFu)) << 32) | ntohl(v >> 32);
+    }
+
+    bool isSeen(uint64_t seq) const { return seen[seq % kWindow] == seq; }
+    void markSeen(uint64_t seq) { seen[seq % kWindow] = seq; }
+    void clearSeen(uint64_t seq) { seen[seq % kWindow] = 0; }
+
+    DeliverFn deliver;
+    GapFn onGap;
+    uint64_t nextExpected = 0;
+    uint64_t seen[kWindow] = {}; // Slot holds the sequence occupying it
+};
+
+int main(int argc, char* argv[]) {
     int sockfd;
     struct sockaddr_in localAddr;
     struct ip_mreq mreq;
     char buffer[1024];
+    const bool low_latency = argc > 1 && std::strcmp(argv[1], "--lowlat") == 0;
+    const bool arbiter_mode = argc > 1 && std::strcmp(argv[1], "--arbiter") == 0;
 
     // Create socket
     if ((sockfd = socket(AF_INET, SOCK_DGRAM, 0)) < 0) {
@@ -56,6 +189,68 @@ int main() {
         return -1;
     }
 
+    if (arbiter_mode) {
+        // Join the B line as well; both lines land on this socket and the
+        // arbiter dedupes by sequence, so line identity doesn't matter.
+        mreq.imr_multiaddr.s_addr = inet_addr(MULTICAST_ADDR_B);
+        if (setsockopt(sockfd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+            perror("setsockopt (B line) failed");
+            close(sockfd);
+            return -1;
+        }
+        std::cout << "Arbitrating lines " << MULTICAST_ADDR << " and "
+                  << MULTICAST_ADDR_B << std::endl;
+
+        FeedArbiter arbiter(
+            [](uint64_t seq, std::string_view payload) {
+                std::cout << "Delivered seq " << seq << ": " << payload << std::endl;
+            },
+            [](uint64_t fromSeq, uint64_t toSeq) {
+                // Recovery hook: a production receiver NACKs or replays here.
+                std::cerr << "Gap detected: missing [" << fromSeq << ", "
+                          << toSeq << ")" << std::endl;
+            });
+
+        while (true) {
+            const ssize_t n = recv(sockfd, buffer, sizeof(buffer), 0);
+            if (n < 0) {
+                perror("recv failed");
+                break;
+            }
+            arbiter.onPacket(buffer, static_cast<size_t>(n));
+        }
+        close(sockfd);
+        return 0;
+    }
+
+    if (low_latency) {
+        LowLatencyConfig cfg;
+        if (!configure_low_latency(sockfd, cfg)) {
+            close(sockfd);
+            return -1;
+        }
+        std::cout << "Receiving in busy-poll mode" << std::endl;
+
+        PacketBufferPool pool;
+        while (true) {
+            char* slot = pool.nextSlot();
+            const ssize_t n = recv(sockfd, slot, PacketBufferPool::kSlotSize - 1, 0);
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    _mm_pause(); // Nothing queued; spin without syscall backoff
+                    continue;
+                }
+                perror("recv failed");
+                break;
+            }
+            // Zero-copy view into the pool slot — no buffer ownership change.
+            std::string_view packet(slot, static_cast<size_t>(n));
+            std::cout << "Received: " << packet << std::endl;
+        }
+        close(sockfd);
+        return 0;
+    }
+
     // Receive messages
     while (true) {
         ssize_t n = recv(sockfd, buffer, sizeof(buffer) - 1, 0);
@@ -1,14 +1,159 @@
 #include <iostream>
 #include <cstring>
+#include <cstdint>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <sys/socket.h>
+#include <array>
+#include <chrono>
+#include <thread>
 
-const char* MULTICAST_ADDR = "239.0.0.1";
+// Redundant A/B feed lines: every datagram carries a sequence number and is
+// published to both groups, so receivers can arbitrate whichever copy lands
+// first and detect gaps per line.
+const char* MULTICAST_ADDR_A = "239.0.0.1";
+const char* MULTICAST_ADDR_B = "239.0.0.2";
 const int PORT = 12345;
 
+// Wire header prepended to every payload: 64-bit sequence in network order.
+struct FeedHeader {
+    uint64_t sequence_be;
+};
+
+static uint64_t htonll(uint64_t v) {
+    return (static_cast<uint64_t>(htonl(v & 0xFFFFFFFFu)) << 32) | htonl(v >> 32);
+}
+
+// Batched, paced publish path. One sendto per update means one syscall per
+// update — at feed rates the syscall dominates, and the unpaced back-to-back
+// bursts between sleeps overflow switch buffers and drop datagrams on the
+// receivers. Two fixes, composed:
+//
+//  - Coalescing: updates are gathered until the batch fills or the oldest
+//    queued update has waited the coalescing window, then the whole batch
+//    goes to the kernel in a single sendmmsg() call per line. The window
+//    bounds the latency cost of waiting for a full batch.
+//
+//  - Pacing: a token bucket (refilled at the target packet rate, capped at
+//    a burst allowance) gates each flush. A flush that would exceed the
+//    allowance sleeps until enough tokens accrue, so the wire sees a smooth
+//    stream below the switch buffer limit instead of line-rate bursts.
+class BatchedPublisher {
+public:
+    static constexpr size_t kMaxBatch = 64;       // Messages per sendmmsg
+    static constexpr size_t kMaxPayload = 1024;
+
+    BatchedPublisher(int sockfd, const sockaddr_in* lineA, const sockaddr_in* lineB,
+                     std::chrono::microseconds coalesceWindow,
+                     double packetsPerSecond, double burstPackets)
+        : sockfd(sockfd), lines{lineA, lineB}, coalesceWindow(coalesceWindow),
+          packetsPerSecond(packetsPerSecond), burstPackets(burstPackets),
+          tokens(burstPackets), lastRefill(std::chrono::steady_clock::now()) {}
+
+    // Queues one datagram. Flushes when the batch is full or the oldest
+    // queued datagram has aged past the coalescing window.
+    void publish(const void* data, size_t len) {
+        Slot& slot = batch[count];
+        memcpy(slot.data, data, len);
+        slot.len = len;
+        if (count++ == 0) {
+            oldestQueued = std::chrono::steady_clock::now();
+        }
+        if (count == kMaxBatch ||
+            std::chrono::steady_clock::now() - oldestQueued >= coalesceWindow) {
+            flush();
+        }
+    }
+
+    // Sends everything queued: one sendmmsg per line, gated by the pacer.
+    void flush() {
+        if (count == 0) {
+            return;
+        }
+
+        // Both lines carry every datagram; pace the combined wire load once
+        // up front so the A and B copies of a batch stay adjacent.
+        pace(count * lines.size());
+
+        mmsghdr msgs[kMaxBatch];
+        iovec iovs[kMaxBatch];
+        for (const sockaddr_in* line : lines) {
+            for (size_t i = 0; i < count; ++i) {
+                iovs[i].iov_base = batch[i].data;
+                iovs[i].iov_len = batch[i].len;
+                memset(&msgs[i], 0, sizeof(msgs[i]));
+                msgs[i].msg_hdr.msg_name = const_cast<sockaddr_in*>(line);
+                msgs[i].msg_hdr.msg_namelen = sizeof(*line);
+                msgs[i].msg_hdr.msg_iov = &iovs[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+            }
+            // sendmmsg may send fewer than asked; resume from where it stopped.
+            size_t sent = 0;
+            while (sent < count) {
+                int n = sendmmsg(sockfd, msgs + sent, count - sent, 0);
+                if (n < 0) {
+                    perror("sendmmsg failed");
+                    break;
+                }
+                sent += n;
+            }
+            packetsSent += sent;
+        }
+        ++batchesSent;
+        count = 0;
+    }
+
+    size_t packets() const { return packetsSent; }
+    size_t batches() const { return batchesSent; }
+
+private:
+    // Blocks until the bucket holds `needed` tokens (one token = one packet
+    // on the wire). Refills at packetsPerSecond, capped at burstPackets so
+    // an idle spell can't bank an arbitrarily large burst.
+    void pace(size_t needed) {
+        for (;;) {
+            const auto now = std::chrono::steady_clock::now();
+            tokens += packetsPerSecond *
+                      std::chrono::duration<double>(now - lastRefill).count();
+            if (tokens > burstPackets) {
+                tokens = burstPackets;
+            }
+            lastRefill = now;
+            if (tokens >= static_cast<double>(needed)) {
+                tokens -= static_cast<double>(needed);
+                return;
+            }
+            const double deficit = static_cast<double>(needed) - tokens;
+            std::this_thread::sleep_for(
+                std::chrono::duration<double>(deficit / packetsPerSecond));
+        }
+    }
+
+    struct Slot {
+        char data[kMaxPayload];
+        size_t len = 0;
+    };
+
+    int sockfd;
+    std::array<const sockaddr_in*, 2> lines;
+    std::chrono::microseconds coalesceWindow;
+    double packetsPerSecond;
+    double burstPackets;
+
+    Slot batch[kMaxBatch];
+    size_t count = 0;
+    std::chrono::steady_clock::time_point oldestQueued;
+
+    double tokens;
+    std::chrono::steady_clock::time_point lastRefill;
+
+    size_t packetsSent = 0;
+    size_t batchesSent = 0;
+};
+
 int main() {
     int sockfd;
-    struct sockaddr_in multicastAddr;
+    struct sockaddr_in lineA, lineB;
 
     // Create socket
     if ((sockfd = socket(AF_INET, SOCK_DGRAM, 0)) < 0) {
@@ -16,21 +161,41 @@ int main() {
         return -1;
     }
 
-    // Set up the multicast address structure
-    memset(&multicastAddr, 0, sizeof(multicastAddr));
-    multicastAddr.sin_family = AF_INET;
-    multicastAddr.sin_addr.s_addr = inet_addr(MULTICAST_ADDR);
-    multicastAddr.sin_port = htons(PORT);
+    // Set up both line addresses
+    memset(&lineA, 0, sizeof(lineA));
+    lineA.sin_family = AF_INET;
+    lineA.sin_addr.s_addr = inet_addr(MULTICAST_ADDR_A);
+    lineA.sin_port = htons(PORT);
+    lineB = lineA;
+    lineB.sin_addr.s_addr = inet_addr(MULTICAST_ADDR_B);
+
+    // Pace to 20k packets/sec on the wire (10k updates/sec across two
+    // lines), with a burst allowance of two full batches.
+    BatchedPublisher publisher(sockfd, &lineA, &lineB,
+                               std::chrono::microseconds(500),
+                               20000.0, 2.0 * BatchedPublisher::kMaxBatch * 2);
 
-    // Loop to send messages
+    // Publish a burst of sequence-stamped updates each second. Within the
+    // burst the updates coalesce into sendmmsg batches and the pacer smooths
+    // them onto the wire; between bursts the server idles like before.
+    uint64_t sequence = 1;
+    constexpr int kUpdatesPerBurst = 1000;
+    char packet[1024];
     while (true) {
-        const char* message = "Wassup from multicast server!";
-        if (sendto(sockfd, message, strlen(message), 0,
-                   (struct sockaddr*)&multicastAddr, sizeof(multicastAddr)) < 0) {
-            perror("sendto failed");
-        } else {
-            std::cout << "Sent: " << message << std::endl;
+        const uint64_t first = sequence;
+        for (int i = 0; i < kUpdatesPerBurst; ++i) {
+            const char* message = "Wassup from multicast server!";
+            FeedHeader header{htonll(sequence)};
+            memcpy(packet, &header, sizeof(header));
+            memcpy(packet + sizeof(header), message, strlen(message));
+            publisher.publish(packet, sizeof(header) + strlen(message));
+            ++sequence;
         }
+        publisher.flush(); // Don't leave a partial batch waiting out the idle second
+        std::cout << "Sent seq " << first << ".." << (sequence - 1) << " ("
+                  << publisher.packets() << " packets in "
+                  << publisher.batches() << " sendmmsg batches so far)"
+                  << std::endl;
         sleep(1); // Wait for a second
     }
 
@@ -1,15 +1,61 @@
 #include <iostream>
 #include <cstring>
+#include <string>
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include "reliable_udp.h"
+
 #define PORT 8080
 #define SERVER_IP "127.0.0.1"
 #define BUFFER_SIZE 1024
 
-int main() {
+// Reliable send mode: stream numbered messages through ReliableSender and
+// service any NACKs the server sends back while we drain.
+static int run_reliable_client(int count) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        perror("Socket creation failed");
+        return -1;
+    }
+    fcntl(fd, F_SETFL, O_NONBLOCK); // NACKs are polled between sends
+
+    sockaddr_in dest{};
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(reliable_udp::RELIABLE_PORT);
+    dest.sin_addr.s_addr = inet_addr(SERVER_IP);
+
+    reliable_udp::ReliableSender sender(fd, dest);
+    char packet[sizeof(reliable_udp::PacketHeader) + reliable_udp::MAX_PAYLOAD];
+
+    for (int i = 0; i < count; ++i) {
+        sender.send("message " + std::to_string(i));
+        const ssize_t n = recv(fd, packet, sizeof(packet), 0);
+        if (n > 0) {
+            sender.onNack(packet, static_cast<size_t>(n));
+        }
+    }
+    // Linger briefly for trailing NACKs before dropping the retransmit ring.
+    for (int i = 0; i < 100; ++i) {
+        const ssize_t n = recv(fd, packet, sizeof(packet), 0);
+        if (n > 0) {
+            sender.onNack(packet, static_cast<size_t>(n));
+        }
+        usleep(1000);
+    }
+    std::cout << "Sent " << count << " messages reliably." << std::endl;
+    close(fd);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     int client_fd;
+
+    if (argc > 1 && std::strcmp(argv[1], "--reliable") == 0) {
+        return run_reliable_client(1000);
+    }
     struct sockaddr_in server_addr;
     char buffer[BUFFER_SIZE];
     
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+// Thin reliability layer over the raw UDP sockets in this directory: every
+// data packet carries a 64-bit sequence header, the receiver detects gaps
+// and sends NACKs naming the missing sequences, and the sender retransmits
+// from a ring of recent payloads. Unlike TCP there is no head-of-line
+// blocking (packets after a gap are buffered and delivered the moment the
+// hole fills) and no slow-start — the application keeps its own pacing.
+
+namespace reliable_udp {
+
+constexpr uint16_t RELIABLE_PORT = 8081;
+constexpr size_t MAX_PAYLOAD = 1024;
+
+inline uint64_t htonll_u64(uint64_t value) {
+    if constexpr (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) {
+        return __builtin_bswap64(value);
+    }
+    return value;
+}
+
+inline uint64_t ntohll_u64(uint64_t value) { return htonll_u64(value); }
+
+enum PacketType : uint8_t {
+    DATA = 0,
+    NACK = 1, // Payload: N network-order 64-bit sequences to retransmit
+};
+
+// Wire header preceding every packet in both directions.
+struct PacketHeader {
+    uint8_t type;
+    uint64_t sequence_be; // DATA: this packet's sequence; NACK: unused
+} __attribute__((packed));
+
+// Sender side: stamps sequences and keeps the last kRingSize payloads for
+// retransmission. The ring is a slot array indexed by sequence & mask so a
+// NACKed sequence is found in O(1); a sequence older than one lap has been
+// overwritten and is reported lost.
+class ReliableSender {
+public:
+    static constexpr size_t kRingSize = 1024; // Power of two
+
+    ReliableSender(int fd, const sockaddr_in& dest) : fd_(fd), dest_(dest) {}
+
+    // Send one payload with the next sequence number, retaining a copy.
+    bool send(std::string_view payload) {
+        if (payload.size() > MAX_PAYLOAD) {
+            return false;
+        }
+        const uint64_t seq = next_sequence_++;
+        Slot& slot = ring_[seq & (kRingSize - 1)];
+        slot.sequence = seq;
+        slot.length = payload.size();
+        std::memcpy(slot.payload, payload.data(), payload.size());
+        return transmit(slot);
+    }
+
+    // Handle a NACK packet: retransmit every requested sequence still in the
+    // ring. Returns the number of sequences that were too old to recover.
+    int onNack(const char* packet, size_t length) {
+        if (length < sizeof(PacketHeader)) {
+            return 0;
+        }
+        const char* cursor = packet + sizeof(PacketHeader);
+        const size_t count = (length - sizeof(PacketHeader)) / sizeof(uint64_t);
+        int unrecoverable = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t seq_be;
+            std::memcpy(&seq_be, cursor + i * sizeof(uint64_t), sizeof(seq_be));
+            const uint64_t seq = ntohll_u64(seq_be);
+            const Slot& slot = ring_[seq & (kRingSize - 1)];
+            if (slot.sequence == seq && slot.length > 0) {
+                transmit(slot);
+            } else {
+                ++unrecoverable; // Lapped: payload no longer retained
+            }
+        }
+        return unrecoverable;
+    }
+
+    uint64_t nextSequence() const { return next_sequence_; }
+
+private:
+    struct Slot {
+        uint64_t sequence = UINT64_MAX;
+        size_t length = 0;
+        char payload[MAX_PAYLOAD];
+    };
+
+    bool transmit(const Slot& slot) {
+        char packet[sizeof(PacketHeader) + MAX_PAYLOAD];
+        PacketHeader header{DATA, htonll_u64(slot.sequence)};
+        std::memcpy(packet, &header, sizeof(header));
+        std::memcpy(packet + sizeof(header), slot.payload, slot.length);
+        const ssize_t sent = sendto(fd_, packet, sizeof(header) + slot.length, 0,
+                                    reinterpret_cast<const sockaddr*>(&dest_), sizeof(dest_));
+        return sent >= 0;
+    }
+
+    int fd_;
+    sockaddr_in dest_;
+    uint64_t next_sequence_ = 0;
+    Slot ring_[kRingSize];
+};
+
+// Receiver side: delivers payloads to the callback strictly in sequence
+// order. Packets arriving ahead of a gap park in a window keyed by
+// sequence & mask. Each missing sequence is NACKed exactly once when the
+// gap is first revealed (a NACK horizon prevents every later out-of-order
+// packet from re-requesting the same holes and flooding the sender);
+// resendNacks() re-requests anything still outstanding and should be
+// called on an idle timeout to recover from lost NACKs or retransmits.
+class ReliableReceiver {
+public:
+    static constexpr size_t kWindow = 1024; // Power of two
+    using DeliverFn = void (*)(uint64_t sequence, std::string_view payload, void* context);
+
+    ReliableReceiver(int fd, DeliverFn deliver, void* context = nullptr)
+        : fd_(fd), deliver_(deliver), context_(context) {}
+
+    // Feed one received packet (header + payload). `sender` is where NACKs
+    // go — for a connected flow this is constant, but recvfrom hands it to
+    // us per packet anyway.
+    void onPacket(const char* packet, size_t length, const sockaddr_in& sender) {
+        if (length < sizeof(PacketHeader)) {
+            return;
+        }
+        PacketHeader header;
+        std::memcpy(&header, packet, sizeof(header));
+        if (header.type != DATA) {
+            return;
+        }
+        const uint64_t seq = ntohll_u64(header.sequence_be);
+        const char* payload = packet + sizeof(header);
+        const size_t payload_len = length - sizeof(header);
+
+        if (seq < next_expected_) {
+            return; // Duplicate of an already-delivered packet
+        }
+        if (seq >= next_expected_ + kWindow) {
+            return; // Too far ahead to buffer; sender will be NACKed later
+        }
+
+        last_sender_ = sender;
+        if (seq == next_expected_) {
+            deliver_(seq, std::string_view(payload, payload_len), context_);
+            ++next_expected_;
+            drainWindow();
+            return;
+        }
+
+        // Out of order: park it and NACK only the newly revealed holes —
+        // everything below nack_horizon_ has been requested already.
+        Slot& slot = window_[seq & (kWindow - 1)];
+        if (slot.sequence != seq) {
+            slot.sequence = seq;
+            slot.length = payload_len;
+            std::memcpy(slot.payload, payload, payload_len);
+        }
+        const uint64_t from = std::max(next_expected_, nack_horizon_);
+        if (seq > from) {
+            sendNack(from, seq, sender);
+        }
+        if (seq > nack_horizon_) {
+            nack_horizon_ = seq;
+        }
+    }
+
+    // Re-request every sequence still missing below the NACK horizon. Call
+    // when the stream has gone quiet while a gap is open; the once-per-gap
+    // NACK (or the retransmit it provoked) may itself have been lost.
+    void resendNacks() {
+        if (nack_horizon_ > next_expected_) {
+            sendNack(next_expected_, nack_horizon_, last_sender_);
+        }
+    }
+
+    uint64_t nextExpected() const { return next_expected_; }
+    bool hasGap() const { return nack_horizon_ > next_expected_; }
+
+private:
+    struct Slot {
+        uint64_t sequence = UINT64_MAX;
+        size_t length = 0;
+        char payload[MAX_PAYLOAD];
+    };
+
+    void drainWindow() {
+        for (;;) {
+            Slot& slot = window_[next_expected_ & (kWindow - 1)];
+            if (slot.sequence != next_expected_) {
+                return;
+            }
+            deliver_(slot.sequence, std::string_view(slot.payload, slot.length), context_);
+            slot.sequence = UINT64_MAX;
+            ++next_expected_;
+        }
+    }
+
+    // Request every missing sequence in [from, to) that is not already
+    // parked in the window.
+    void sendNack(uint64_t from, uint64_t to, const sockaddr_in& sender) {
+        char packet[sizeof(PacketHeader) + MAX_PAYLOAD];
+        PacketHeader header{NACK, 0};
+        std::memcpy(packet, &header, sizeof(header));
+        size_t offset = sizeof(header);
+        for (uint64_t seq = from; seq < to && offset + sizeof(uint64_t) <= sizeof(packet); ++seq) {
+            if (window_[seq & (kWindow - 1)].sequence == seq) {
+                continue; // Already buffered, not missing
+            }
+            const uint64_t seq_be = htonll_u64(seq);
+            std::memcpy(packet + offset, &seq_be, sizeof(seq_be));
+            offset += sizeof(seq_be);
+        }
+        if (offset > sizeof(header)) {
+            sendto(fd_, packet, offset, 0,
+                   reinterpret_cast<const sockaddr*>(&sender), sizeof(sender));
+        }
+    }
+
+    int fd_;
+    DeliverFn deliver_;
+    void* context_;
+    uint64_t next_expected_ = 0;
+    uint64_t nack_horizon_ = 0; // Sequences below this have been NACKed
+    sockaddr_in last_sender_{};
+    Slot window_[kWindow];
+};
+
+} // namespace reliable_udp
@@ -1,60 +1,179 @@
 #include <iostream>
 #include <cstring>
+#include <span>
+#include <string_view>
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include "reliable_udp.h"
+
 #define PORT 8080
 #define BUFFER_SIZE 1024
+#define BATCH_SIZE 64
+
+// One received datagram: a view into the preallocated receive buffers plus
+// the sender address, valid until the next batch is received.
+struct PacketView {
+    std::string_view payload;
+    const sockaddr_in* sender;
+};
+
+// Batched receive loop: one recvmmsg syscall drains up to BATCH_SIZE
+// datagrams into preallocated buffers. No per-packet syscall and no memset —
+// the kernel-returned lengths bound each payload view.
+class BatchedReceiver {
+public:
+    explicit BatchedReceiver(int fd) : fd(fd) {
+        for (int i = 0; i < BATCH_SIZE; ++i) {
+            iovecs[i].iov_base = buffers[i];
+            iovecs[i].iov_len = BUFFER_SIZE;
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+        }
+    }
+
+    // Blocks for at least one datagram, then returns every datagram already
+    // queued (up to BATCH_SIZE) as a span of views. Returns an empty span on
+    // error.
+    std::span<const PacketView> receive() {
+        // msg_namelen is rewritten by the kernel per packet; restore it.
+        for (int i = 0; i < BATCH_SIZE; ++i) {
+            msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+        }
+        const int n = recvmmsg(fd, msgs, BATCH_SIZE, MSG_WAITFORONE, nullptr);
+        if (n < 0) {
+            perror("recvmmsg failed");
+            return {};
+        }
+        for (int i = 0; i < n; ++i) {
+            views[i].payload = std::string_view(buffers[i], msgs[i].msg_len);
+            views[i].sender = &addrs[i];
+        }
+        return std::span<const PacketView>(views, static_cast<size_t>(n));
+    }
+
+private:
+    int fd;
+    char buffers[BATCH_SIZE][BUFFER_SIZE];
+    iovec iovecs[BATCH_SIZE];
+    mmsghdr msgs[BATCH_SIZE] = {};
+    sockaddr_in addrs[BATCH_SIZE];
+    PacketView views[BATCH_SIZE];
+};
+
+// In-order delivery sink for the reliable mode.
+static void print_delivered(uint64_t sequence, std::string_view payload, void*) {
+    std::cout << "Delivered #" << sequence << ": " << payload << std::endl;
+}
+
+// Reliable receive loop: raw recvfrom plus the sequencing/NACK layer. Gaps
+// are NACKed back to the sender and filled packets drain in order.
+static int run_reliable_server() {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        perror("Socket creation failed");
+        return -1;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(reliable_udp::RELIABLE_PORT);
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0) {
+        perror("Bind failed");
+        close(fd);
+        return -1;
+    }
+    // A short receive timeout bounds how long an open gap waits before the
+    // outstanding NACKs are re-sent (lost NACKs or retransmits otherwise
+    // stall the stream forever).
+    timeval timeout{0, 100000}; // 100ms
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    std::cout << "Reliable server listening on port " << reliable_udp::RELIABLE_PORT << std::endl;
+
+    reliable_udp::ReliableReceiver receiver(fd, print_delivered);
+    char packet[sizeof(reliable_udp::PacketHeader) + reliable_udp::MAX_PAYLOAD];
+    while (true) {
+        sockaddr_in sender{};
+        socklen_t sender_len = sizeof(sender);
+        const ssize_t n = recvfrom(fd, packet, sizeof(packet), 0,
+                                   reinterpret_cast<sockaddr*>(&sender), &sender_len);
+        if (n > 0) {
+            receiver.onPacket(packet, static_cast<size_t>(n), sender);
+        } else if (receiver.hasGap()) {
+            receiver.resendNacks();
+        }
+    }
+}
 
-int main() {
+int main(int argc, char* argv[]) {
     int server_fd;
     struct sockaddr_in server_addr, client_addr;
     char buffer[BUFFER_SIZE];
-    
+    const bool batch_mode = argc > 1 && std::strcmp(argv[1], "--batch") == 0;
+
+    if (argc > 1 && std::strcmp(argv[1], "--reliable") == 0) {
+        return run_reliable_server();
+    }
+
     // Create a UDP socket
     if ((server_fd = socket(AF_INET, SOCK_DGRAM, 0)) < 0) {
         perror("Socket creation failed");
         return -1;
     }
-    
+
     // Configure server address structure
     memset(&server_addr, 0, sizeof(server_addr));
     server_addr.sin_family = AF_INET;
     server_addr.sin_addr.s_addr = INADDR_ANY;
     server_addr.sin_port = htons(PORT);
-    
+
     // Bind the socket to the specified port
     if (bind(server_fd, (const struct sockaddr *)&server_addr, sizeof(server_addr)) < 0) {
         perror("Bind failed");
         close(server_fd);
         return -1;
     }
-    
-    std::cout << "Server listening on port " << PORT << std::endl;
-    
+
+    std::cout << "Server listening on port " << PORT
+              << (batch_mode ? " (batched recvmmsg mode)" : "") << std::endl;
+
+    if (batch_mode) {
+        BatchedReceiver receiver(server_fd);
+        std::string response = "Hello from server!";
+        while (true) {
+            for (const PacketView& packet : receiver.receive()) {
+                std::cout << "Received from client: " << packet.payload << std::endl;
+                sendto(server_fd, response.c_str(), response.length(), MSG_CONFIRM,
+                       (const struct sockaddr *)packet.sender, sizeof(*packet.sender));
+            }
+        }
+    }
+
     socklen_t len = sizeof(client_addr);
     int n;
-    
+
     // Server loop to receive messages
     while (true) {
         memset(buffer, 0, BUFFER_SIZE);
-        
+
         // Receive message from client
-        n = recvfrom(server_fd, (char *)buffer, BUFFER_SIZE, MSG_WAITALL, 
+        n = recvfrom(server_fd, (char *)buffer, BUFFER_SIZE, MSG_WAITALL,
                      (struct sockaddr *)&client_addr, &len);
         buffer[n] = '\0';
-        
+
         std::cout << "Received from client: " << buffer << std::endl;
-        
+
         // Send response to client
         std::string response = "Hello from server!";
         sendto(server_fd, response.c_str(), response.length(), MSG_CONFIRM,
                (const struct sockaddr *)&client_addr, len);
-        
+
         std::cout << "Response sent to client" << std::endl;
     }
-    
+
     close(server_fd);
     return 0;
 }
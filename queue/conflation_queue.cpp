@@ -0,0 +1,146 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <type_traits>
+
+// Conflating queue for price-like data: a lagging consumer of a regular
+// queue (simple_concurrent_queue.cpp) works through an unbounded backlog of
+// stale prices before seeing a current one. But for last-value semantics
+// only the newest update per symbol matters — so instead of queueing, the
+// producer overwrites a fixed per-symbol slot and flags it in a dirty
+// bitmap. Memory is O(symbols) no matter how far behind the consumer is,
+// and a consumer that wakes up from a stall reads current prices
+// immediately; the intervening updates are conflated away.
+//
+// Slots are seqlock-protected: the producer's writes are wait-free (no CAS
+// loop, no consumer can block it), and the consumer retries the rare read
+// that races a write. One writer per symbol — the usual feed arrangement,
+// where a symbol belongs to one exchange session. Values must be trivially
+// copyable since a torn read is copied before the retry check discards it.
+template<typename T, size_t NumSymbols>
+class ConflationQueue {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Seqlock readers copy slots that the producer may be rewriting");
+
+public:
+    // Overwrite the symbol's slot with the latest value and mark it dirty.
+    void publish(size_t symbolId, const T& value) {
+        Slot& slot = slots_[symbolId];
+        const uint32_t seq = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(seq + 1, std::memory_order_relaxed); // Odd: writing
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value = value;
+        slot.sequence.store(seq + 2, std::memory_order_release);
+        dirty_[symbolId / 64].fetch_or(uint64_t(1) << (symbolId % 64),
+                                       std::memory_order_release);
+    }
+
+    // Visit the latest value of every symbol updated since the last drain.
+    // Claims whole bitmap words with exchange(0), so producer and consumer
+    // never loop against each other. Returns the number of symbols visited.
+    template<typename Fn>
+    size_t drain(Fn&& fn) {
+        size_t visited = 0;
+        for (size_t word = 0; word < kWords; ++word) {
+            uint64_t bits = dirty_[word].exchange(0, std::memory_order_acquire);
+            while (bits != 0) {
+                const size_t symbolId = word * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                fn(symbolId, readSlot(symbolId));
+                ++visited;
+            }
+        }
+        return visited;
+    }
+
+private:
+    static constexpr size_t kWords = (NumSymbols + 63) / 64;
+
+    // One cache line per symbol: the producer's overwrite never false-shares
+    // with a neighbouring symbol's reads.
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> sequence{0}; // Odd while the producer writes
+        T value{};
+    };
+
+    T readSlot(size_t symbolId) const {
+        const Slot& slot = slots_[symbolId];
+        for (;;) {
+            const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue; // Mid-write; the producer finishes promptly
+            }
+            T copy = slot.value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                return copy;
+            }
+        }
+    }
+
+    Slot slots_[NumSymbols];
+    std::atomic<uint64_t> dirty_[kWords] = {};
+};
+
+struct PriceUpdate {
+    int symbolId;
+    double price;
+    long timestamp;
+};
+
+constexpr size_t kNumSymbols = 64;
+
+ConflationQueue<PriceUpdate, kNumSymbols> conflated;
+std::atomic<bool> stopFlag(false);
+std::atomic<long> published(0);
+
+// Producer: full-rate updates across all symbols, far faster than the
+// consumer drains. A buffering queue would grow by this surplus forever.
+void producer() {
+    long tick = 0;
+    while (!stopFlag) {
+        const size_t symbolId = tick % kNumSymbols;
+        conflated.publish(symbolId,
+                          PriceUpdate{static_cast<int>(symbolId),
+                                      100.0 + (tick % 100) / 100.0, tick});
+        published.fetch_add(1, std::memory_order_relaxed);
+        ++tick;
+    }
+    std::cout << "Producer stopped after " << tick << " updates.\n";
+}
+
+// Deliberately slow consumer: one scan per millisecond. With conflation its
+// work per scan is bounded by the symbol count, and every price it sees is
+// the latest one at scan time — no stale backlog to chew through.
+void consumer() {
+    long consumed = 0;
+    long scans = 0;
+    long lastTimestampSeen = -1;
+    while (!stopFlag) {
+        consumed += conflated.drain([&](size_t, const PriceUpdate& update) {
+            lastTimestampSeen = std::max(lastTimestampSeen, update.timestamp);
+        });
+        ++scans;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::cout << "Consumer stopped: " << consumed << " prices over " << scans
+              << " scans (" << published.load() << " published; "
+              << published.load() - consumed << " conflated away).\n"
+              << "Last timestamp seen: " << lastTimestampSeen << "\n";
+}
+
+int main() {
+    std::thread producerThread(producer);
+    std::thread consumerThread(consumer);
+
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    stopFlag = true;
+
+    producerThread.join();
+    consumerThread.join();
+
+    std::cout << "Application stopped.\n";
+    return 0;
+}
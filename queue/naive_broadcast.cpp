@@ -1,23 +1,29 @@
 #include <memory>
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
 #include <mutex>
 #include <atomic>
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include "concurrentqueue.h"
+#include "../cpputils/slab_pool.cpp"
+#include "../cpputils/latency_probe.cpp" // TscClock + per-hop histograms
 
 template<typename T>
 class Broadcaster {
 public:
     class Subscriber {
     private:
-        moodycamel::ConcurrentQueue<std::shared_ptr<const T>> queue;
+        moodycamel::ConcurrentQueue<SharedPtr<T>> queue;
         std::atomic<bool> active{true};
         friend class Broadcaster;
 
     public:
-        bool receive(std::shared_ptr<const T>& item) {
+        bool receive(SharedPtr<T>& item) {
             return queue.try_dequeue(item);
         }
 
@@ -27,23 +33,44 @@ public:
     };
 
 private:
-    std::vector<std::weak_ptr<Subscriber>> subscribers;
-    std::mutex subscriberMutex;
+    // RCU-style subscriber list: broadcast() loads an immutable snapshot and
+    // walks raw pointers — no mutex, no weak_ptr lock (an atomic CAS) per
+    // subscriber per message. Subscribe/unsubscribe are the rare writers;
+    // they build a fresh snapshot under the mutex and atomically swap it in.
+    // The snapshot co-owns its subscribers, so a broadcast holding an old
+    // snapshot can never touch a destroyed one.
+    struct Snapshot {
+        std::vector<Subscriber*> active;                // Hot: walked per broadcast
+        std::vector<std::shared_ptr<Subscriber>> owners; // Cold: lifetime only
+    };
+
+    std::atomic<std::shared_ptr<const Snapshot>> snapshot{std::make_shared<const Snapshot>()};
+    std::mutex subscriberMutex; // Serializes writers only
+    SlabPool<T> messagePool{4096}; // Recycled message slots; sized for the slowest subscriber's lag
+
+    void rebuildSnapshot(std::vector<std::shared_ptr<Subscriber>> owners) {
+        auto next = std::make_shared<Snapshot>();
+        next->owners = std::move(owners);
+        for (const auto& sub : next->owners) {
+            next->active.push_back(sub.get());
+        }
+        snapshot.store(std::move(next), std::memory_order_release);
+    }
 
 public:
     void broadcast(const T& item) {
-        auto sharedItem = std::make_shared<T>(item);
-        std::lock_guard<std::mutex> lock(subscriberMutex);
-        for (auto it = subscribers.begin(); it != subscribers.end();) {
-            if (auto sub = it->lock()) {
-                if (sub->active) {
-                    sub->queue.enqueue(sharedItem);
-                    ++it;
-                } else {
-                    it = subscribers.erase(it);
-                }
-            } else {
-                it = subscribers.erase(it);
+        // Messages come from the slab pool: slot plus refcount in one
+        // cache-line allocation made at startup, recycled by the pooled
+        // deleter when the last subscriber drops its reference. The heap
+        // fallback only fires if subscribers fall a full pool behind.
+        SharedPtr<T> sharedItem = messagePool.makeShared(item);
+        if (sharedItem.get() == nullptr) {
+            sharedItem = my_make_shared<T>(item);
+        }
+        const auto snap = snapshot.load(std::memory_order_acquire);
+        for (Subscriber* sub : snap->active) {
+            if (sub->active) {
+                sub->queue.enqueue(sharedItem);
             }
         }
     }
@@ -51,13 +78,106 @@ public:
     std::shared_ptr<Subscriber> subscribe() {
         auto sub = std::make_shared<Subscriber>();
         std::lock_guard<std::mutex> lock(subscriberMutex);
+        auto owners = snapshot.load(std::memory_order_acquire)->owners;
+        owners.push_back(sub);
+        rebuildSnapshot(std::move(owners));
+        return sub;
+    }
+
+    void unsubscribe(const std::shared_ptr<Subscriber>& sub) {
+        sub->active = false;
+        std::lock_guard<std::mutex> lock(subscriberMutex);
+        auto owners = snapshot.load(std::memory_order_acquire)->owners;
+        owners.erase(std::remove(owners.begin(), owners.end(), sub), owners.end());
+        rebuildSnapshot(std::move(owners));
+    }
+};
+
+// Arena-backed broadcast mode: messages live by value in a fixed ring of
+// slabs and subscribers receive raw const T* into the arena, so the fan-out
+// path does no make_shared and no refcount traffic at all. A slot is
+// reclaimed (reusable by the producer) once every subscriber's cursor has
+// moved past it — the cursors are the epochs. Only trivially-copyable
+// payloads qualify since slots are recycled by plain overwrite.
+template<typename T, size_t Capacity = 1024>
+class ArenaBroadcaster {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Arena broadcast recycles slots by overwrite; T must be trivially copyable");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    class Subscriber {
+        friend class ArenaBroadcaster;
+
+    public:
+        // Hands out a pointer into the arena; the slot stays valid until the
+        // next receive() call, which releases it back toward the producer.
+        bool receive(const T*& item) {
+            if (holding) {
+                cursor.store(cursor.load(std::memory_order_relaxed) + 1,
+                             std::memory_order_release);
+                holding = false;
+            }
+            const uint64_t mine = cursor.load(std::memory_order_relaxed);
+            if (mine >= parent->published.load(std::memory_order_acquire)) {
+                return false;
+            }
+            item = &parent->slots[mine & (Capacity - 1)];
+            holding = true;
+            return true;
+        }
+
+        bool is_active() const { return active; }
+
+    private:
+        ArenaBroadcaster* parent = nullptr;
+        alignas(64) std::atomic<uint64_t> cursor{0};
+        bool holding = false; // Consumer-side only
+        std::atomic<bool> active{true};
+    };
+
+    // Subscribers must be registered before broadcasting starts; the arena's
+    // reclamation is gated on a fixed cursor set.
+    std::shared_ptr<Subscriber> subscribe() {
+        auto sub = std::make_shared<Subscriber>();
+        sub->parent = this;
+        sub->cursor.store(producerSequence, std::memory_order_relaxed);
         subscribers.push_back(sub);
         return sub;
     }
 
     void unsubscribe(const std::shared_ptr<Subscriber>& sub) {
         sub->active = false;
+        // A leaving subscriber stops gating reclamation.
+        sub->cursor.store(UINT64_MAX, std::memory_order_release);
+    }
+
+    // One value store per message; blocks (spins) only when the slowest
+    // subscriber is a full arena behind.
+    bool try_broadcast(const T& item) {
+        const uint64_t next = producerSequence + 1;
+        if (next - minCursor() > Capacity) {
+            return false;
+        }
+        slots[producerSequence & (Capacity - 1)] = item;
+        producerSequence = next;
+        published.store(next, std::memory_order_release);
+        return true;
     }
+
+private:
+    uint64_t minCursor() const {
+        uint64_t min = UINT64_MAX;
+        for (const auto& sub : subscribers) {
+            min = std::min(min, sub->cursor.load(std::memory_order_acquire));
+        }
+        return min == UINT64_MAX ? producerSequence : min;
+    }
+
+    std::array<T, Capacity> slots;
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    alignas(64) uint64_t producerSequence = 0;
+    alignas(64) std::atomic<uint64_t> published{0};
 };
 
 std::mutex coutMutex;
@@ -67,16 +187,35 @@ void safePrint(const std::string& message) {
     std::cout << message << std::endl;
 }
 
+// Stamped payload for hop measurement: the producer takes one raw TSC read
+// at publish, each consumer converts the delta at receive. Per-hop sites
+// ("broadcast_hop", "arena_hop") separate the shared-ptr fan-out from the
+// arena fan-out in the percentile report.
+struct StampedPrice {
+    int value;
+    uint64_t publish_tsc;
+};
+
+static void recordHop(const char* site, uint64_t publish_tsc) {
+    static thread_local LatencyHistogram* broadcast_hist =
+        ProbeRegistry::instance().histogramFor("broadcast_hop");
+    static thread_local LatencyHistogram* arena_hist =
+        ProbeRegistry::instance().histogramFor("arena_hop");
+    LatencyHistogram* hist = site[0] == 'a' ? arena_hist : broadcast_hist;
+    hist->record(TscClock::instance().to_ns(TscClock::cycles() - publish_tsc));
+}
+
 int main() {
-    Broadcaster<int> broadcaster;
+    Broadcaster<StampedPrice> broadcaster;
 
     // Consumer 1
     auto sub1 = broadcaster.subscribe();
     std::thread consumer1([sub1]() {
-        std::shared_ptr<const int> item;
+        SharedPtr<StampedPrice> item;
         while (sub1->is_active()) {
             if (sub1->receive(item)) {
-                safePrint("Consumer 1 received: " + std::to_string(*item));
+                recordHop("broadcast", item->publish_tsc);
+                safePrint("Consumer 1 received: " + std::to_string(item->value));
             }
         }
     });
@@ -84,17 +223,18 @@ int main() {
     // Consumer 2
     auto sub2 = broadcaster.subscribe();
     std::thread consumer2([sub2]() {
-        std::shared_ptr<const int> item;
+        SharedPtr<StampedPrice> item;
         while (sub2->is_active()) {
             if (sub2->receive(item)) {
-                safePrint("Consumer 2 received: " + std::to_string(*item));
+                recordHop("broadcast", item->publish_tsc);
+                safePrint("Consumer 2 received: " + std::to_string(item->value));
             }
         }
     });
 
     // Producer
     for (int i = 0; i < 10; ++i) {
-        broadcaster.broadcast(i);
+        broadcaster.broadcast(StampedPrice{i, TscClock::cycles()});
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 
@@ -104,5 +244,38 @@ int main() {
     consumer1.join();
     consumer2.join();
 
+    // Same fan-out through the arena mode: no make_shared, no refcounts —
+    // consumers read raw pointers into the slot ring.
+    ArenaBroadcaster<StampedPrice> arena;
+    auto asub1 = arena.subscribe();
+    auto asub2 = arena.subscribe();
+
+    auto arenaConsumer = [](std::shared_ptr<ArenaBroadcaster<StampedPrice>::Subscriber> sub, int id) {
+        const StampedPrice* item = nullptr;
+        while (sub->is_active()) {
+            if (sub->receive(item)) {
+                recordHop("arena", item->publish_tsc);
+                safePrint("Arena consumer " + std::to_string(id) + " received: " + std::to_string(item->value));
+            }
+        }
+    };
+    std::thread aconsumer1(arenaConsumer, asub1, 1);
+    std::thread aconsumer2(arenaConsumer, asub2, 2);
+
+    for (int i = 0; i < 10; ++i) {
+        while (!arena.try_broadcast(StampedPrice{i, TscClock::cycles()})) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    arena.unsubscribe(asub1);
+    arena.unsubscribe(asub2);
+    aconsumer1.join();
+    aconsumer2.join();
+
+    // Per-hop p50/p99/p999 for both fan-out paths.
+    ProbeRegistry::instance().report(*spdlog::default_logger());
+
     return 0;
 }
@@ -2,9 +2,11 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <algorithm>
 #include <chrono>
-#include <memory> // For std::shared_ptr
-#include "concurrentqueue.h" // Include Moodycamel's ConcurrentQueue
+#include <cstdint>
+#include "wait_strategy.h"
+#include "../cpputils/cpu_topology.cpp"
 
 // Define a structure to represent a price update message.
 struct PriceUpdate {
@@ -13,24 +15,94 @@ struct PriceUpdate {
     long timestamp;
 };
 
-// Each consumer has its own queue with shared pointers to PriceUpdate.
-std::vector<moodycamel::ConcurrentQueue<std::shared_ptr<PriceUpdate>>> consumerQueues;
+// LMAX-disruptor-style broadcast ring: the producer writes each message once
+// into a shared ring and publishes a monotonically increasing sequence; every
+// consumer reads the same slots through its own cursor. This replaces the old
+// per-consumer ConcurrentQueue fan-out, which cost one enqueue plus shared_ptr
+// refcount traffic per consumer per message. The producer is gated on the
+// slowest consumer's cursor so slots are never overwritten while still in use.
+template<typename T, size_t Capacity>
+class BroadcastRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // `storage_node` places the slot array on one NUMA node
+    // (numa_alloc_onnode) so dequeues from consumers pinned there never
+    // cross the socket interconnect.
+    BroadcastRing(size_t numConsumers, int storage_node)
+        : slots(Capacity, storage_node), cursors(numConsumers) {
+        for (auto& c : cursors) {
+            c.sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Single-producer publish: one store into the ring, one release store of
+    // the sequence. Returns false when the slowest consumer is a full ring
+    // behind (caller decides whether to spin or drop).
+    bool tryPublish(const T& item) {
+        const uint64_t next = producerSequence + 1;
+        if (next - minConsumerSequence() > Capacity) {
+            return false; // Slowest consumer would be lapped
+        }
+        slots[producerSequence & (Capacity - 1)] = item;
+        producerSequence = next;
+        published.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Per-consumer read: consumes the next message for `consumerId` if one is
+    // available, advancing only that consumer's cursor.
+    bool tryConsume(size_t consumerId, T& out) {
+        auto& cursor = cursors[consumerId];
+        const uint64_t mine = cursor.sequence.load(std::memory_order_relaxed);
+        if (mine >= published.load(std::memory_order_acquire)) {
+            return false; // Nothing new for this consumer
+        }
+        out = slots[mine & (Capacity - 1)];
+        cursor.sequence.store(mine + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Each consumer cursor sits on its own cache line so consumers draining
+    // at different rates don't invalidate each other.
+    struct alignas(64) Cursor {
+        std::atomic<uint64_t> sequence;
+    };
+
+    uint64_t minConsumerSequence() const {
+        uint64_t min = UINT64_MAX;
+        for (const auto& c : cursors) {
+            min = std::min(min, c.sequence.load(std::memory_order_acquire));
+        }
+        return min;
+    }
+
+    NumaArray<T> slots;
+    std::vector<Cursor> cursors;
+    alignas(64) uint64_t producerSequence = 0;      // Producer-only
+    alignas(64) std::atomic<uint64_t> published{0}; // Producer publishes, consumers acquire
+};
+
+constexpr size_t kRingCapacity = 1024;
+BroadcastRing<PriceUpdate, kRingCapacity>* broadcastRing = nullptr;
+PlacementSpec* placement = nullptr;
 std::atomic<bool> stopFlag(false); // To signal consumers to stop
 
 // Producer function
-void producer(int numConsumers) {
+void producer() {
+    placement->pinCurrentThread("producer");
     int symbolId = 1; // Single symbol for simplicity
 
     while (!stopFlag) {
-        // Create a shared pointer to a new PriceUpdate instance
-        auto update = std::make_shared<PriceUpdate>();
-        update->symbolId = symbolId;
-        update->price = 100.0 + (rand() % 100) / 100.0; // Random price
-        update->timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-        
-        // Push the shared pointer to each consumer's queue
-        for (int i = 0; i < numConsumers; ++i) {
-            consumerQueues[i].enqueue(update);
+        // Write the update once; every consumer reads the same slot.
+        PriceUpdate update;
+        update.symbolId = symbolId;
+        update.price = 100.0 + (rand() % 100) / 100.0; // Random price
+        update.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+
+        while (!broadcastRing->tryPublish(update) && !stopFlag) {
+            std::this_thread::yield(); // Gated on the slowest consumer
         }
 
         std::this_thread::sleep_for(std::chrono::milliseconds(10)); // Simulate data arrival every 10ms
@@ -39,19 +111,22 @@ void producer(int numConsumers) {
     std::cout << "Producer stopped.\n";
 }
 
-// Consumer function
+// Consumer function: spin-then-yield instead of a fixed 100us sleep when the
+// ring is empty, so quiet symbols don't add a sleep quantum to tail latency.
 void consumer(int consumerId) {
+    placement->pinCurrentThread("consumer-" + std::to_string(consumerId));
+    SpinYieldWaitStrategy strategy;
     while (!stopFlag) {
-        std::shared_ptr<PriceUpdate> update;
-        if (consumerQueues[consumerId].try_dequeue(update)) {
+        PriceUpdate update;
+        if (broadcastRing->tryConsume(consumerId, update)) {
+            strategy.reset();
             // Process the price update
             std::cout << "Consumer " << consumerId + 1 << " processed update: "
-                      << "SymbolId: " << update->symbolId
-                      << ", Price: " << update->price
-                      << ", Timestamp: " << update->timestamp << "\n";
+                      << "SymbolId: " << update.symbolId
+                      << ", Price: " << update.price
+                      << ", Timestamp: " << update.timestamp << "\n";
         } else {
-            // No data available, wait a little before retrying
-            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            strategy.idle();
         }
     }
 
@@ -62,11 +137,28 @@ int main() {
     // Define the number of consumers
     int numConsumers = 4;
 
-    // Initialize a queue for each consumer
-    consumerQueues.resize(numConsumers);
+    // Place consumers (and the ring storage) on one node and keep the
+    // producer with them when the node is big enough; a consumer that
+    // migrates across the socket pays ~2.5x on every dequeue.
+    CpuTopology topology;
+    const int storage_node = topology.cpus().empty() ? 0 : topology.cpus().front().node;
+    const std::vector<int> local_cpus = topology.cpusOnNode(storage_node);
+
+    PlacementSpec spec;
+    spec.place("producer", local_cpus[0]);
+    for (int i = 0; i < numConsumers; ++i) {
+        spec.place("consumer-" + std::to_string(i), local_cpus[(i + 1) % local_cpus.size()]);
+    }
+    spec.reportCrossNode(storage_node, std::cout);
+    placement = &spec;
+
+    // One shared ring replaces the per-consumer queues, its slots allocated
+    // on the consumers' node.
+    BroadcastRing<PriceUpdate, kRingCapacity> ring(numConsumers, storage_node);
+    broadcastRing = &ring;
 
     // Start the producer thread
-    std::thread producerThread(producer, numConsumers);
+    std::thread producerThread(producer);
 
     // Start multiple consumer threads
     std::vector<std::thread> consumerThreads;
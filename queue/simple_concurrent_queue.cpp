@@ -3,51 +3,88 @@
 #include <vector>
 #include <atomic>
 #include <chrono>
-#include "concurrentqueue.h" // Include Moodycamel's ConcurrentQueue
+#include "token_channel.h"   // Tokened bulk channel over moodycamel's queue
+#include "wait_strategy.h"   // Pluggable consumer wait strategies
+#include "../cpputils/latency_probe.cpp" // TscClock + histogram reporting
 
-// Define a structure to represent a price update message.
+// Define a structure to represent a price update message. The stamp is a
+// raw TSC read (~7ns, no vDSO call): the producer stamps at enqueue and the
+// consumer converts the cycle delta to nanoseconds at dequeue, so the
+// histogram measures the queue hop itself rather than two clock_gettime
+// calls bracketing it.
 struct PriceUpdate {
     int symbolId;
     double price;
-    long timestamp;
+    uint64_t enqueue_tsc;
 };
 
-// Define the queue with a single producer and multiple consumers.
-moodycamel::ConcurrentQueue<PriceUpdate> priceQueue;
+// Single channel, one producer and multiple consumers. Each thread makes
+// its own Sender/Receiver handle so every operation runs tokened instead
+// of through the queue's implicit-producer hash lookup.
+Channel<PriceUpdate> priceChannel;
 std::atomic<bool> stopFlag(false); // To signal consumers to stop
 
+// Batch sizes for the bulk paths: updates arrive from the feed in small
+// clumps, so the producer gathers a clump and enqueues it as one operation.
+constexpr size_t kEnqueueBatch = 8;
+constexpr size_t kDequeueBatch = 16;
+
 // Producer function
 void producer() {
+    auto sender = priceChannel.sender(); // This thread's ProducerToken
     int symbolId = 1; // Single symbol for simplicity
 
     while (!stopFlag) {
-        PriceUpdate update;
-        update.symbolId = symbolId;
-        update.price = 100.0 + (rand() % 100) / 100.0; // Random price
-        update.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-        
-        // Push update to the queue
-        priceQueue.enqueue(update);
+        // Gather a clump of updates and push them with one enqueue_bulk:
+        // one ticket acquisition for the whole batch. Each update is
+        // stamped when it is created, so the histogram still charges the
+        // time an update spends waiting for its batch to fill.
+        PriceUpdate batch[kEnqueueBatch];
+        for (PriceUpdate& update : batch) {
+            update.symbolId = symbolId;
+            update.price = 100.0 + (rand() % 100) / 100.0; // Random price
+            update.enqueue_tsc = TscClock::cycles();
+        }
+        sender.sendBulk(batch, kEnqueueBatch);
         std::this_thread::sleep_for(std::chrono::milliseconds(10)); // Simulate data arrival every 10ms
     }
 
     std::cout << "Producer stopped.\n";
 }
 
-// Consumer function
-void consumer(int consumerId) {
+// Consumer function. Latency-critical consumers spin with _mm_pause instead
+// of sleeping 100us per empty poll; batch consumers spin-then-yield so they
+// stay polite on shared cores. The strategy is chosen per consumer.
+template<typename WaitStrategy>
+void consumer(int consumerId, WaitStrategy strategy) {
+    auto receiver = priceChannel.receiver(); // This thread's ConsumerToken
+    PriceUpdate batch[kDequeueBatch];
+    size_t got = 0;
+
     while (!stopFlag) {
-        PriceUpdate update;
-        if (priceQueue.try_dequeue(update)) {
-            // Process the price update
-            std::cout << "Consumer " << consumerId << " processed update: "
-                      << "SymbolId: " << update.symbolId
-                      << ", Price: " << update.price
-                      << ", Timestamp: " << update.timestamp << "\n";
-        } else {
-            // No data available, wait a little before retrying
-            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        const bool any = dequeue_wait(
+            strategy,
+            [&receiver, &batch, &got]() {
+                got = receiver.tryReceiveBulk(batch, kDequeueBatch);
+                return got != 0;
+            },
+            std::chrono::milliseconds(1));
+        if (any) {
+            // Enqueue-to-dequeue latency into this thread's histogram for
+            // the site; the record is a relaxed increment, not a lock.
+            static thread_local LatencyHistogram* hist =
+                ProbeRegistry::instance().histogramFor("queue_hop");
+            const uint64_t now = TscClock::cycles();
+            for (size_t i = 0; i < got; ++i) {
+                hist->record(TscClock::instance().to_ns(now - batch[i].enqueue_tsc));
+            }
+
+            // Process the price updates
+            std::cout << "Consumer " << consumerId << " processed " << got
+                      << " updates, last: SymbolId: " << batch[got - 1].symbolId
+                      << ", Price: " << batch[got - 1].price << "\n";
         }
+        // Timed out: loop re-checks stopFlag, then waits again.
     }
 
     std::cout << "Consumer " << consumerId << " stopped.\n";
@@ -58,10 +95,12 @@ int main() {
     std::thread producerThread(producer);
 
     // Start multiple consumer threads
-    int numConsumers = 4;
     std::vector<std::thread> consumerThreads;
-    for (int i = 0; i < numConsumers; ++i) {
-        consumerThreads.emplace_back(consumer, i + 1);
+    // Consumer 1 is on the execution path: pin-and-spin. The rest are batch
+    // consumers and yield once their spin budget runs out.
+    consumerThreads.emplace_back(consumer<BusySpinWaitStrategy>, 1, BusySpinWaitStrategy{});
+    for (int i = 1; i < 4; ++i) {
+        consumerThreads.emplace_back(consumer<SpinYieldWaitStrategy>, i + 1, SpinYieldWaitStrategy{});
     }
 
     // Run the application for a limited time (e.g., 2 seconds) for this example
@@ -74,6 +113,9 @@ int main() {
         thread.join();
     }
 
+    // Per-hop percentiles (p50/p99/p999) from the drained histograms.
+    ProbeRegistry::instance().report(*spdlog::default_logger());
+
     std::cout << "Application stopped.\n";
     return 0;
 }
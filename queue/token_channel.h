@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "concurrentqueue.h"
+
+// Typed channel over moodycamel::ConcurrentQueue with explicit tokens.
+// Tokenless enqueue()/try_dequeue() route every operation through the
+// queue's implicit-producer hash lookup; a ProducerToken pins a thread to
+// its own sub-queue and a ConsumerToken caches which sub-queue to drain
+// next, and the bulk operations amortize the ticket machinery across a
+// whole batch — the library's own benchmarks put tokened bulk ops at ~2x
+// the tokenless single-item path.
+//
+// Usage: share one Channel<T>; each thread constructs its own Sender or
+// Receiver handle. Tokens are not thread-safe, so handles must not be
+// shared across threads (make one per thread, typically on the stack of
+// the thread function).
+
+template<typename T>
+class Channel {
+public:
+    explicit Channel(size_t initialCapacity = 1024) : queue(initialCapacity) {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    // Producer-side handle; owns this thread's ProducerToken.
+    class Sender {
+    public:
+        explicit Sender(Channel& channel)
+            : queue(channel.queue), token(channel.queue) {}
+
+        bool send(const T& item) { return queue.enqueue(token, item); }
+        bool send(T&& item) { return queue.enqueue(token, std::move(item)); }
+
+        // Enqueues `count` items as one operation; all-or-nothing.
+        bool sendBulk(const T* items, size_t count) {
+            return queue.enqueue_bulk(token, items, count);
+        }
+
+    private:
+        moodycamel::ConcurrentQueue<T>& queue;
+        moodycamel::ProducerToken token;
+    };
+
+    // Consumer-side handle; owns this thread's ConsumerToken.
+    class Receiver {
+    public:
+        explicit Receiver(Channel& channel)
+            : queue(channel.queue), token(channel.queue) {}
+
+        bool tryReceive(T& item) { return queue.try_dequeue(token, item); }
+
+        // Dequeues up to `maxCount` items; returns how many were taken.
+        size_t tryReceiveBulk(T* items, size_t maxCount) {
+            return queue.try_dequeue_bulk(token, items, maxCount);
+        }
+
+    private:
+        moodycamel::ConcurrentQueue<T>& queue;
+        moodycamel::ConsumerToken token;
+    };
+
+    Sender sender() { return Sender(*this); }
+    Receiver receiver() { return Receiver(*this); }
+
+    size_t sizeApprox() const { return queue.size_approx(); }
+
+private:
+    moodycamel::ConcurrentQueue<T> queue;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <thread>
+#include <emmintrin.h> // _mm_pause
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Pluggable wait strategies for queue consumers. The demos used to do
+// sleep_for(100us) whenever try_dequeue came back empty, which puts up to
+// 100us of idle time on the tail latency of the next message. Instead a
+// consumer picks a strategy matching its latency budget:
+//
+//   BusySpinWaitStrategy   - _mm_pause loop, lowest latency, burns a core
+//   SpinYieldWaitStrategy  - spin a while, then yield to the scheduler
+//   FutexParkWaitStrategy  - spin briefly, then park in the kernel until
+//                            the producer signals
+//
+// Each strategy exposes idle()/reset(), and FutexParkWaitStrategy adds a
+// producer-side notify. dequeue_wait() below builds a blocking dequeue with
+// timeout out of any strategy and any try_dequeue-style callable.
+
+class BusySpinWaitStrategy {
+public:
+    void idle() { _mm_pause(); }
+    void reset() {}
+};
+
+class SpinYieldWaitStrategy {
+public:
+    explicit SpinYieldWaitStrategy(int spinLimit = 4000) : spinLimit(spinLimit) {}
+
+    void idle() {
+        if (spins++ < spinLimit) {
+            _mm_pause();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    void reset() { spins = 0; }
+
+private:
+    const int spinLimit;
+    int spins = 0;
+};
+
+class FutexParkWaitStrategy {
+public:
+    explicit FutexParkWaitStrategy(int spinLimit = 1000) : spinLimit(spinLimit) {}
+
+    void idle() {
+        if (spins++ < spinLimit) {
+            _mm_pause();
+            return;
+        }
+        // Park until the producer bumps the word; spurious wakes are fine,
+        // the caller re-checks the queue either way.
+        const uint32_t seen = word.load(std::memory_order_acquire);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+                FUTEX_WAIT_PRIVATE, seen, nullptr, nullptr, 0);
+        spins = 0;
+    }
+
+    void reset() { spins = 0; }
+
+    // Producer side: call after enqueueing so parked consumers wake.
+    void notify() {
+        word.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+                FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+private:
+    const int spinLimit;
+    int spins = 0;
+    std::atomic<uint32_t> word{0};
+};
+
+// Blocking dequeue with timeout built on any wait strategy: `tryDequeue` is
+// any callable returning bool (e.g. a lambda over try_dequeue). Returns false
+// if nothing arrived within the timeout.
+template<typename WaitStrategy, typename TryDequeue>
+bool dequeue_wait(WaitStrategy& strategy, TryDequeue&& tryDequeue,
+                  std::chrono::nanoseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    strategy.reset();
+    while (!tryDequeue()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        strategy.idle();
+    }
+    return true;
+}
@@ -0,0 +1,118 @@
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <arrow/ipc/api.h>
+#include <arrow/result.h>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// C++ reader counterpart to write_arrow_shm.cpp (the Python scripts decode a
+// copy; this one does not). The IPC stream bytes stay in the mapped region:
+// arrays are constructed as views over the shared buffers — no memcpy, no
+// decode — and IpcReadOptions::included_fields prunes columns before their
+// buffers are even touched, so a volume-only consumer never faults in the
+// timestamp and price pages.
+
+const char* SHM_NAME = "arrow_shm";
+
+struct Metadata {
+    int num_tables;
+    int64_t table_size_bytes[1];  // Flexible array member
+};
+
+void handle_status(const arrow::Status& status) {
+    if (!status.ok()) {
+        std::cerr << "Arrow error: " << status.ToString() << std::endl;
+        exit(1);
+    }
+}
+
+// Zero-copy accessor over one serialized table in the region. The wrapping
+// arrow::Buffer does not own the bytes; the mapped_region must outlive every
+// array handed out.
+class ShmTableReader {
+public:
+    ShmTableReader(const uint8_t* data, int64_t size)
+        : buffer_(std::make_shared<arrow::Buffer>(data, size)) {
+        // One cheap open to learn the schema; no batches are read here.
+        arrow::io::BufferReader source(buffer_);
+        auto maybe_reader = arrow::ipc::RecordBatchStreamReader::Open(&source);
+        handle_status(maybe_reader.status());
+        schema_ = maybe_reader.ValueOrDie()->schema();
+    }
+
+    std::shared_ptr<arrow::Schema> schema() const { return schema_; }
+
+    // Materialize the whole table (still zero-copy: array buffers are slices
+    // of the shared region).
+    std::shared_ptr<arrow::Table> read_all() const {
+        return read(arrow::ipc::IpcReadOptions::Defaults());
+    }
+
+    // Materialize only the named columns. Unknown names are ignored so a
+    // consumer can ask optimistically across schema versions.
+    std::shared_ptr<arrow::Table> read_columns(const std::vector<std::string>& names) const {
+        arrow::ipc::IpcReadOptions options = arrow::ipc::IpcReadOptions::Defaults();
+        for (const std::string& name : names) {
+            const int index = schema_->GetFieldIndex(name);
+            if (index >= 0) {
+                options.included_fields.push_back(index);
+            }
+        }
+        return read(options);
+    }
+
+private:
+    std::shared_ptr<arrow::Table> read(const arrow::ipc::IpcReadOptions& options) const {
+        arrow::io::BufferReader source(buffer_);
+        auto maybe_reader = arrow::ipc::RecordBatchStreamReader::Open(&source, options);
+        handle_status(maybe_reader.status());
+        auto maybe_table = maybe_reader.ValueOrDie()->ToTable();
+        handle_status(maybe_table.status());
+        return maybe_table.ValueOrDie();
+    }
+
+    std::shared_ptr<arrow::Buffer> buffer_;
+    std::shared_ptr<arrow::Schema> schema_;
+};
+
+int main(int argc, char* argv[]) {
+    using namespace boost::interprocess;
+
+    // Columns to materialize; no arguments means everything.
+    std::vector<std::string> wanted;
+    for (int i = 1; i < argc; ++i) {
+        wanted.emplace_back(argv[i]);
+    }
+
+    shared_memory_object shm(open_only, SHM_NAME, read_only);
+    mapped_region region(shm, read_only);
+    const char* mem = static_cast<const char*>(region.get_address());
+
+    const Metadata* metadata = reinterpret_cast<const Metadata*>(mem);
+    const int num_tables = metadata->num_tables;
+    const int64_t metadata_size = sizeof(Metadata) + (num_tables - 1) * sizeof(int64_t);
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(mem + metadata_size);
+    int64_t offset = 0;
+    for (int i = 0; i < num_tables; ++i) {
+        ShmTableReader reader(data + offset, metadata->table_size_bytes[i]);
+        offset += metadata->table_size_bytes[i];
+
+        std::shared_ptr<arrow::Table> table =
+            wanted.empty() ? reader.read_all() : reader.read_columns(wanted);
+
+        std::cout << "Table " << i + 1 << ": " << table->num_rows() << " rows, "
+                  << table->num_columns() << " of " << reader.schema()->num_fields()
+                  << " columns materialized" << std::endl;
+        for (const auto& field : table->schema()->fields()) {
+            std::cout << "  " << field->name() << ": " << field->type()->ToString()
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
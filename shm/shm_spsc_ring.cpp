@@ -0,0 +1,197 @@
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <iostream>
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+// Cross-process SPSC message ring: the LocklessRingBuffer algorithm from
+// cpputils/wub_ring_buffer.cpp laid out in a boost.interprocess region (the
+// same mechanism write_arrow_shm.cpp uses for its tables). Producer and
+// consumer map the region and exchange trivially-copyable messages at
+// in-process ring cost — no serialization, no file handoff. A heartbeat
+// word lets the consumer detect a dead producer instead of spinning forever.
+//
+//     ./shm_spsc_ring --producer   # one process
+//     ./shm_spsc_ring --consumer   # another
+//
+// Run with no arguments for a single-binary self-test over two threads that
+// each map the region independently.
+
+const char* RING_SHM_NAME = "spsc_price_ring";
+
+// Same message the in-process pipeline uses (queue/simple_concurrent_queue.cpp).
+struct PriceUpdate {
+    int symbolId;
+    double price;
+    long timestamp;
+};
+
+// The shared layout. Indices are monotonic with a power-of-two mask, and the
+// producer/consumer lines are separated exactly as in LocklessRingBuffer.
+// Cached opposing indices live in the per-process handles below, not here —
+// they are private optimizations, not shared state.
+template<typename T, size_t Capacity>
+struct ShmRingLayout {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "shared-memory messages must be trivially copyable");
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+    static constexpr uint32_t kMagic = 0x52494e47; // "RING"
+
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+    alignas(64) std::atomic<uint64_t> heartbeat_ns{0}; // Producer liveness
+    alignas(64) std::atomic<uint32_t> magic{0};        // Set last during init
+    std::array<T, Capacity> slots;
+};
+
+using PriceRingLayout = ShmRingLayout<PriceUpdate, 1024>;
+
+uint64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Producer-side handle: creates (or truncates) the region and owns the
+// cached consumer index.
+class ShmRingProducer {
+public:
+    ShmRingProducer() {
+        using namespace boost::interprocess;
+        shared_memory_object shm(open_or_create, RING_SHM_NAME, read_write);
+        shm.truncate(sizeof(PriceRingLayout));
+        region_ = mapped_region(shm, read_write);
+        ring_ = new (region_.get_address()) PriceRingLayout();
+        ring_->heartbeat_ns.store(steady_now_ns(), std::memory_order_relaxed);
+        ring_->magic.store(PriceRingLayout::kMagic, std::memory_order_release);
+    }
+
+    bool push(const PriceUpdate& update) {
+        const uint64_t current_head = ring_->head.load(std::memory_order_relaxed);
+        if (current_head - cached_tail_ == ring_->slots.size()) {
+            cached_tail_ = ring_->tail.load(std::memory_order_acquire);
+            if (current_head - cached_tail_ == ring_->slots.size()) {
+                return false; // Ring is full
+            }
+        }
+        ring_->slots[current_head & (ring_->slots.size() - 1)] = update;
+        ring_->head.store(current_head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Called periodically (every few ms is plenty); consumers treat a stale
+    // heartbeat as a crashed producer.
+    void beat() {
+        ring_->heartbeat_ns.store(steady_now_ns(), std::memory_order_relaxed);
+    }
+
+private:
+    boost::interprocess::mapped_region region_;
+    PriceRingLayout* ring_;
+    uint64_t cached_tail_{0};
+};
+
+// Consumer-side handle: attaches to an existing region.
+class ShmRingConsumer {
+public:
+    ShmRingConsumer() {
+        using namespace boost::interprocess;
+        shared_memory_object shm(open_only, RING_SHM_NAME, read_write);
+        region_ = mapped_region(shm, read_write);
+        ring_ = static_cast<PriceRingLayout*>(region_.get_address());
+        // Wait for the producer's release-store of the magic word so we
+        // never read a half-constructed layout.
+        while (ring_->magic.load(std::memory_order_acquire) != PriceRingLayout::kMagic) {
+            std::this_thread::yield();
+        }
+    }
+
+    bool pop(PriceUpdate& out) {
+        const uint64_t current_tail = ring_->tail.load(std::memory_order_relaxed);
+        if (current_tail == cached_head_) {
+            cached_head_ = ring_->head.load(std::memory_order_acquire);
+            if (current_tail == cached_head_) {
+                return false; // Ring is empty
+            }
+        }
+        out = ring_->slots[current_tail & (ring_->slots.size() - 1)];
+        ring_->tail.store(current_tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // True while the producer's heartbeat is fresher than `timeout_ms`.
+    bool producer_alive(int timeout_ms = 100) const {
+        const uint64_t last = ring_->heartbeat_ns.load(std::memory_order_relaxed);
+        return steady_now_ns() - last < static_cast<uint64_t>(timeout_ms) * 1000000ull;
+    }
+
+private:
+    boost::interprocess::mapped_region region_;
+    PriceRingLayout* ring_;
+    uint64_t cached_head_{0};
+};
+
+void run_producer(int count) {
+    ShmRingProducer producer;
+    for (int i = 0; i < count; ++i) {
+        PriceUpdate update;
+        update.symbolId = 1;
+        update.price = 100.0 + (i % 100) / 100.0;
+        update.timestamp = static_cast<long>(steady_now_ns());
+        while (!producer.push(update)) {
+            producer.beat(); // Keep the heartbeat fresh while backpressured
+        }
+        if ((i & 1023) == 0) {
+            producer.beat();
+        }
+    }
+    producer.beat();
+    std::cout << "Producer published " << count << " updates.\n";
+}
+
+void run_consumer(int count) {
+    ShmRingConsumer consumer;
+    PriceUpdate update;
+    int received = 0;
+    uint64_t latency_sum = 0;
+    while (received < count) {
+        if (consumer.pop(update)) {
+            latency_sum += steady_now_ns() - static_cast<uint64_t>(update.timestamp);
+            ++received;
+        } else if (!consumer.producer_alive()) {
+            std::cout << "Producer heartbeat lost after " << received << " updates.\n";
+            return;
+        }
+    }
+    std::cout << "Consumer received " << received << " updates, avg latency "
+              << latency_sum / received << " ns.\n";
+}
+
+int main(int argc, char* argv[]) {
+    constexpr int kCount = 1000000;
+
+    if (argc > 1 && std::strcmp(argv[1], "--producer") == 0) {
+        boost::interprocess::shared_memory_object::remove(RING_SHM_NAME);
+        run_producer(kCount);
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--consumer") == 0) {
+        run_consumer(kCount);
+        return 0;
+    }
+
+    // Self-test: two threads, two independent mappings of the same region.
+    boost::interprocess::shared_memory_object::remove(RING_SHM_NAME);
+    std::thread producer([] { run_producer(kCount); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::thread consumer([] { run_consumer(kCount); });
+    producer.join();
+    consumer.join();
+    boost::interprocess::shared_memory_object::remove(RING_SHM_NAME);
+    return 0;
+}
@@ -1,13 +1,22 @@
 #include <arrow/api.h>
+#include <arrow/compute/api.h>
 #include <arrow/io/api.h>
 #include <arrow/ipc/api.h>
 #include <arrow/memory_pool.h>
 #include <arrow/result.h>
+#include <arrow/util/compression.h>
 #include <iostream>
+#include <atomic>
+#include <cstring>
+#include <string>
 #include <vector>
 #include <random>
 #include <chrono>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 const char* SHM_NAME = "/tmp/arrow_shm";
 
 struct Metadata {
@@ -54,10 +63,168 @@ std::shared_ptr<arrow::Table> create_table(int num_rows, int64_t start_time) {
     return arrow::Table::Make(schema, {timestamp_array, price_array, volume_array});
 }
 
+// Reusable builder pool: constructs the three column builders once and
+// re-reserves capacity to the high-water row count at the start of each
+// cycle. Finish() moves the builders' buffers into the finished arrays, so
+// the builders come back empty with their capacity released; the up-front
+// Reserve replaces the log2(n) doubling reallocations that plain appends
+// would pay with one allocation per column per table, typically satisfied
+// from the memory pool's just-freed blocks.
+class BuilderPool {
+public:
+    explicit BuilderPool(arrow::MemoryPool* pool = arrow::default_memory_pool())
+        : timestamp_builder(pool), price_builder(pool), volume_builder(pool) {}
+
+    // Re-establish the reservation for the next cycle, growing the
+    // high-water mark to `num_rows`. Runs every cycle: Finish() released
+    // the previous buffers, so Reserve must be repeated even when
+    // num_rows has not grown (it is a no-op only while capacity is
+    // already sufficient).
+    void reserve(int64_t num_rows) {
+        if (num_rows > reserved_rows) {
+            reserved_rows = num_rows;
+        }
+        handle_status(timestamp_builder.Reserve(reserved_rows));
+        handle_status(price_builder.Reserve(reserved_rows));
+        handle_status(volume_builder.Reserve(reserved_rows));
+    }
+
+    arrow::Int64Builder timestamp_builder;
+    arrow::DoubleBuilder price_builder;
+    arrow::DoubleBuilder volume_builder;
+
+private:
+    int64_t reserved_rows = 0;
+};
+
+// create_table variant drawing from a caller-owned BuilderPool; the pool's
+// builders come back empty after Finish (their buffers now belong to the
+// finished arrays) and are re-reserved on the next call.
+std::shared_ptr<arrow::Table> create_table(BuilderPool& builders, int num_rows, int64_t start_time) {
+    builders.reserve(num_rows);
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> price_dist(100.0, 200.0);
+    std::uniform_real_distribution<> volume_dist(1000.0, 10000.0);
+
+    for (int i = 0; i < num_rows; ++i) {
+        handle_status(builders.timestamp_builder.Append(start_time + i * 1000000)); // Increment by 1ms
+        handle_status(builders.price_builder.Append(price_dist(gen)));
+        handle_status(builders.volume_builder.Append(volume_dist(gen)));
+    }
+
+    std::shared_ptr<arrow::Array> timestamp_array;
+    std::shared_ptr<arrow::Array> price_array;
+    std::shared_ptr<arrow::Array> volume_array;
+    handle_status(builders.timestamp_builder.Finish(&timestamp_array));
+    handle_status(builders.price_builder.Finish(&price_array));
+    handle_status(builders.volume_builder.Finish(&volume_array));
+
+    auto schema = arrow::schema({
+        arrow::field("timestamp_nano", arrow::int64()),
+        arrow::field("price", arrow::float64()),
+        arrow::field("volume", arrow::float64())
+    });
+
+    return arrow::Table::Make(schema, {timestamp_array, price_array, volume_array});
+}
+
+// Size/speed presets for the IPC serialization step. Fastest writes raw
+// buffers; Balanced adds LZ4-frame (cheap enough that NVMe write bandwidth,
+// not CPU, stays the bottleneck); Smallest switches to ZSTD for archival
+// rotation where read-back is rare.
+enum class WritePreset {
+    Fastest,   // No compression
+    Balanced,  // LZ4 frame
+    Smallest,  // ZSTD
+};
+
+arrow::ipc::IpcWriteOptions make_write_options(WritePreset preset) {
+    arrow::ipc::IpcWriteOptions options = arrow::ipc::IpcWriteOptions::Defaults();
+    switch (preset) {
+        case WritePreset::Fastest:
+            break;
+        case WritePreset::Balanced: {
+            auto maybe_codec = arrow::util::Codec::Create(arrow::Compression::LZ4_FRAME);
+            handle_status(maybe_codec.status());
+            options.codec = std::move(maybe_codec).ValueOrDie();
+            break;
+        }
+        case WritePreset::Smallest: {
+            auto maybe_codec = arrow::util::Codec::Create(arrow::Compression::ZSTD);
+            handle_status(maybe_codec.status());
+            options.codec = std::move(maybe_codec).ValueOrDie();
+            break;
+        }
+    }
+    return options;
+}
+
+// Dictionary-encode the named columns in place. Low-cardinality string
+// columns (symbol, venue) shrink to an int index per row plus one dictionary
+// per batch, which is where most of the 4-5x file-size win comes from; the
+// IPC writer emits the dictionaries natively.
+std::shared_ptr<arrow::Table> dictionary_encode_columns(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::vector<std::string>& column_names) {
+    std::shared_ptr<arrow::Table> result = table;
+    for (const std::string& name : column_names) {
+        const int index = result->schema()->GetFieldIndex(name);
+        if (index < 0) {
+            continue;
+        }
+        auto maybe_encoded = arrow::compute::DictionaryEncode(result->column(index));
+        handle_status(maybe_encoded.status());
+        auto encoded = maybe_encoded.ValueOrDie().chunked_array();
+        auto field = arrow::field(name, encoded->type());
+        auto maybe_table = result->SetColumn(index, field, encoded);
+        handle_status(maybe_table.status());
+        result = maybe_table.ValueOrDie();
+    }
+    return result;
+}
+
+// Trade-shaped table with a low-cardinality symbol column, for exercising
+// the dictionary path.
+std::shared_ptr<arrow::Table> create_trade_table(int num_rows, int64_t start_time) {
+    arrow::Int64Builder timestamp_builder;
+    arrow::StringBuilder symbol_builder;
+    arrow::DoubleBuilder price_builder;
+
+    static const char* kSymbols[] = {"AAPL", "MSFT", "NVDA", "GOOG"};
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> price_dist(100.0, 200.0);
+
+    for (int i = 0; i < num_rows; ++i) {
+        handle_status(timestamp_builder.Append(start_time + i * 1000000));
+        handle_status(symbol_builder.Append(kSymbols[i % 4]));
+        handle_status(price_builder.Append(price_dist(gen)));
+    }
+
+    std::shared_ptr<arrow::Array> timestamp_array;
+    std::shared_ptr<arrow::Array> symbol_array;
+    std::shared_ptr<arrow::Array> price_array;
+    handle_status(timestamp_builder.Finish(&timestamp_array));
+    handle_status(symbol_builder.Finish(&symbol_array));
+    handle_status(price_builder.Finish(&price_array));
+
+    auto schema = arrow::schema({
+        arrow::field("timestamp_nano", arrow::int64()),
+        arrow::field("symbol", arrow::utf8()),
+        arrow::field("price", arrow::float64())
+    });
+
+    return arrow::Table::Make(schema, {timestamp_array, symbol_array, price_array});
+}
+
 void write_table_to_mmap(const std::shared_ptr<arrow::Table>& table, 
                          std::shared_ptr<arrow::io::MemoryMappedFile> mmap, 
-                         int64_t& offset) {
-    arrow::ipc::IpcWriteOptions options = arrow::ipc::IpcWriteOptions::Defaults();
+                         int64_t& offset,
+                         WritePreset preset = WritePreset::Fastest) {
+    arrow::ipc::IpcWriteOptions options = make_write_options(preset);
     auto maybe_writer = arrow::ipc::MakeStreamWriter(mmap, table->schema(), options);
     handle_status(maybe_writer.status());
     auto writer = maybe_writer.ValueOrDie();
@@ -68,7 +235,276 @@ void write_table_to_mmap(const std::shared_ptr<arrow::Table>& table,
     offset = mmap->Tell().ValueOrDie();
 }
 
-int main() {
+// Mapping options for multi-GB tables: with default 4KB pages a full scan
+// takes ~500k dTLB misses; 2MB pages cut that ~512x. Explicit huge pages
+// (MAP_HUGETLB) are tried first and we fall back to transparent huge pages
+// via madvise(MADV_HUGEPAGE) when the hugetlb pool is empty. SEQUENTIAL
+// readahead and an mlock'd header page are selectable independently.
+struct MappingOptions {
+    bool huge_pages = true;       // MAP_HUGETLB, falling back to MADV_HUGEPAGE
+    bool sequential_hint = true;  // madvise(MADV_SEQUENTIAL)
+    bool lock_header_page = true; // mlock the first page (metadata header)
+};
+
+// Raw mmap of the backing file honoring MappingOptions. Returns the mapping
+// address or exits on hard failure; huge-page failures degrade gracefully.
+char* map_with_options(const char* path, int64_t total_size, const MappingOptions& opts) {
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        perror("open failed");
+        exit(1);
+    }
+    if (ftruncate(fd, total_size) < 0) {
+        perror("ftruncate failed");
+        exit(1);
+    }
+
+    void* addr = MAP_FAILED;
+    if (opts.huge_pages) {
+        // Explicit huge pages need hugetlbfs-backed memory; for a plain file
+        // this generally fails unless `path` lives on hugetlbfs, in which
+        // case the length must be huge-page aligned.
+        addr = mmap(nullptr, total_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_HUGETLB, fd, 0);
+    }
+    if (addr == MAP_FAILED) {
+        addr = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            perror("mmap failed");
+            exit(1);
+        }
+        if (opts.huge_pages && madvise(addr, total_size, MADV_HUGEPAGE) < 0) {
+            perror("madvise MADV_HUGEPAGE (continuing with 4KB pages)");
+        }
+    }
+
+    if (opts.sequential_hint && madvise(addr, total_size, MADV_SEQUENTIAL) < 0) {
+        perror("madvise MADV_SEQUENTIAL (continuing)");
+    }
+    if (opts.lock_header_page &&
+        mlock(addr, static_cast<size_t>(sysconf(_SC_PAGESIZE))) < 0) {
+        perror("mlock header page (continuing)");
+    }
+
+    close(fd); // The mapping keeps its own reference
+    return static_cast<char*>(addr);
+}
+
+// Huge-page write path: serialize tables through a FixedSizeBufferWriter
+// over the raw mapping instead of arrow's MemoryMappedFile (which offers no
+// control over page size or advice).
+void write_tables_hugepage(int64_t total_size, int64_t metadata_size,
+                           const std::vector<int>& rows_per_table) {
+    MappingOptions opts;
+    char* mem = map_with_options(SHM_NAME, total_size, opts);
+
+    Metadata* metadata = reinterpret_cast<Metadata*>(mem);
+    metadata->num_tables = static_cast<int>(rows_per_table.size());
+
+    auto buffer = std::make_shared<arrow::MutableBuffer>(
+        reinterpret_cast<uint8_t*>(mem + metadata_size), total_size - metadata_size);
+    arrow::io::FixedSizeBufferWriter sink(buffer);
+
+    int64_t current_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+
+    BuilderPool builders;
+    int64_t prev_offset = 0;
+    for (size_t i = 0; i < rows_per_table.size(); ++i) {
+        auto table = create_table(builders, rows_per_table[i], current_time + i * 1000000000);
+        auto maybe_writer = arrow::ipc::MakeStreamWriter(&sink, table->schema(),
+                                                         arrow::ipc::IpcWriteOptions::Defaults());
+        handle_status(maybe_writer.status());
+        auto writer = maybe_writer.ValueOrDie();
+        handle_status(writer->WriteTable(*table));
+        handle_status(writer->Close());
+
+        const int64_t offset = sink.Tell().ValueOrDie();
+        metadata->table_size_bytes[i] = offset - prev_offset;
+        std::cout << "Table " << i + 1 << " size: " << metadata->table_size_bytes[i]
+                  << " bytes" << std::endl;
+        prev_offset = offset;
+    }
+
+    munmap(mem, total_size);
+}
+
+// Rotating snapshot regions. Re-creating the mapping each rotation costs an
+// open/ftruncate/mmap plus a first-touch page fault on every written page —
+// a multi-millisecond stall injected into the writer once a second. Instead
+// a fixed pool of regions is created and prefaulted once, up front
+// (MAP_POPULATE, with a touch-every-page fallback), and rotation just
+// advances to the oldest region: a pointer swap, no syscall, no faults.
+//
+// Each region opens with a RotatingMetadata header carrying a generation
+// number: odd while the writer is filling the region, even once the
+// snapshot is complete. A reader (a separate process mapping the same
+// region files) scans the headers and attaches to the highest even
+// generation; with three regions the writer only ever overwrites the
+// oldest snapshot, so the freshest complete one is never pulled out from
+// under a reader that just picked it.
+struct RotatingMetadata {
+    static constexpr int kMaxTables = 8;
+    std::atomic<uint64_t> generation; // Odd: mid-fill; even: complete snapshot
+    int64_t payload_bytes;
+    int num_tables;
+    int64_t table_size_bytes[kMaxTables];
+};
+
+class SnapshotRotator {
+public:
+    static constexpr int kNumRegions = 3; // Filling / freshest complete / aging out
+
+    SnapshotRotator(const char* path_prefix, int64_t region_size)
+        : region_size(region_size) {
+        for (int i = 0; i < kNumRegions; ++i) {
+            const std::string path = std::string(path_prefix) + "." + std::to_string(i);
+            int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (fd < 0) {
+                perror("open region failed");
+                exit(1);
+            }
+            if (ftruncate(fd, region_size) < 0) {
+                perror("ftruncate region failed");
+                exit(1);
+            }
+            // Prefault at creation, off the rotation path: MAP_POPULATE asks
+            // the kernel to wire every page before mmap returns.
+            void* addr = mmap(nullptr, region_size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                addr = mmap(nullptr, region_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, fd, 0);
+                if (addr == MAP_FAILED) {
+                    perror("mmap region failed");
+                    exit(1);
+                }
+                // Touch-on-init fallback: one write per page faults it in now
+                // instead of during the first snapshot into this region.
+                volatile char* mem = static_cast<volatile char*>(addr);
+                for (int64_t off = 0; off < region_size; off += 4096) {
+                    mem[off] = mem[off];
+                }
+            }
+            close(fd); // The mapping keeps its own reference
+            regions[i] = static_cast<char*>(addr);
+            headerOf(i)->generation.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~SnapshotRotator() {
+        for (int i = 0; i < kNumRegions; ++i) {
+            munmap(regions[i], region_size);
+        }
+    }
+
+    // Begin the next snapshot: cycle to the oldest region and mark it odd so
+    // readers skip it while it fills. Costs a modular increment and one
+    // store — no mapping work, no faults.
+    char* beginSnapshot() {
+        current = (current + 1) % kNumRegions;
+        headerOf(current)->generation.store(nextGeneration * 2 + 1,
+                                            std::memory_order_release);
+        return regions[current] + sizeof(RotatingMetadata);
+    }
+
+    int64_t payloadCapacity() const {
+        return region_size - static_cast<int64_t>(sizeof(RotatingMetadata));
+    }
+
+    // Publish the filled region: write the table directory, then flip the
+    // generation even with release ordering so a reader that observes the
+    // snapshot as complete also observes its contents.
+    void publish(int num_tables, const int64_t* table_sizes, int64_t payload_bytes) {
+        RotatingMetadata* md = headerOf(current);
+        md->payload_bytes = payload_bytes;
+        md->num_tables = num_tables;
+        for (int i = 0; i < num_tables && i < RotatingMetadata::kMaxTables; ++i) {
+            md->table_size_bytes[i] = table_sizes[i];
+        }
+        md->generation.store(++nextGeneration * 2, std::memory_order_release);
+    }
+
+    // Reader side: index of the freshest complete region, or -1 before the
+    // first publish. A real reader runs this over its own mapping of the
+    // region files; it lives here so both sides share the protocol.
+    int freshestRegion() const {
+        int best = -1;
+        uint64_t best_gen = 0;
+        for (int i = 0; i < kNumRegions; ++i) {
+            const uint64_t gen = headerOf(i)->generation.load(std::memory_order_acquire);
+            if (gen != 0 && (gen & 1) == 0 && gen > best_gen) {
+                best_gen = gen;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    uint64_t generationOf(int region) const {
+        return headerOf(region)->generation.load(std::memory_order_acquire);
+    }
+
+private:
+    RotatingMetadata* headerOf(int i) const {
+        return reinterpret_cast<RotatingMetadata*>(regions[i]);
+    }
+
+    char* regions[kNumRegions];
+    int64_t region_size;
+    int current = kNumRegions - 1; // First beginSnapshot() lands on region 0
+    uint64_t nextGeneration = 0;
+};
+
+// Rotation demo: prefault the pool once, then take several timed snapshots.
+// Steady-state rotation should show microseconds, not the ~10ms of a
+// remap-and-fault cycle.
+void write_snapshots_rotating(int64_t region_size, const std::vector<int>& rows_per_table) {
+    SnapshotRotator rotator(SHM_NAME, region_size);
+
+    int64_t current_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+
+    BuilderPool builders;
+    for (int snapshot = 0; snapshot < 5; ++snapshot) {
+        const auto start = std::chrono::steady_clock::now();
+        char* payload = rotator.beginSnapshot();
+
+        auto buffer = std::make_shared<arrow::MutableBuffer>(
+            reinterpret_cast<uint8_t*>(payload), rotator.payloadCapacity());
+        arrow::io::FixedSizeBufferWriter sink(buffer);
+
+        int64_t table_sizes[RotatingMetadata::kMaxTables] = {};
+        int64_t prev_offset = 0;
+        for (size_t i = 0; i < rows_per_table.size(); ++i) {
+            auto table = create_table(builders, rows_per_table[i],
+                                      current_time + snapshot * 1000000000);
+            auto maybe_writer = arrow::ipc::MakeStreamWriter(
+                &sink, table->schema(), arrow::ipc::IpcWriteOptions::Defaults());
+            handle_status(maybe_writer.status());
+            auto writer = maybe_writer.ValueOrDie();
+            handle_status(writer->WriteTable(*table));
+            handle_status(writer->Close());
+
+            const int64_t offset = sink.Tell().ValueOrDie();
+            table_sizes[i] = offset - prev_offset;
+            prev_offset = offset;
+        }
+        rotator.publish(static_cast<int>(rows_per_table.size()), table_sizes, prev_offset);
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        std::cout << "Snapshot " << snapshot + 1 << ": region "
+                  << rotator.freshestRegion() << ", generation "
+                  << rotator.generationOf(rotator.freshestRegion()) << ", "
+                  << prev_offset << " payload bytes, rotation+write took "
+                  << elapsed.count() << "us" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
     const int num_tables = 3;
     const std::vector<int> rows_per_table = {3, 4, 5};  // Variable number of rows
 
@@ -77,6 +513,59 @@ int main() {
     int64_t data_size = num_tables * 1024 * 1024;  // Assume max 1MB per table
     int64_t total_size = metadata_size + data_size;
 
+    // --preset=balanced|smallest: write compressed, dictionary-encoded trade
+    // tables instead of the raw demo tables.
+    WritePreset preset = WritePreset::Fastest;
+    bool preset_given = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--preset=balanced") == 0) {
+            preset = WritePreset::Balanced;
+            preset_given = true;
+        } else if (std::strcmp(argv[i], "--preset=smallest") == 0) {
+            preset = WritePreset::Smallest;
+            preset_given = true;
+        }
+    }
+    if (preset_given) {
+        auto maybe_mmap = arrow::io::MemoryMappedFile::Create(SHM_NAME, total_size);
+        handle_status(maybe_mmap.status());
+        auto mmap = maybe_mmap.ValueOrDie();
+
+        Metadata metadata;
+        metadata.num_tables = num_tables;
+        handle_status(mmap->Write(&metadata, sizeof(Metadata)));
+
+        int64_t offset = metadata_size;
+        int64_t current_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        for (int i = 0; i < num_tables; ++i) {
+            auto table = create_trade_table(rows_per_table[i] * 1000,
+                                            current_time + i * 1000000000);
+            table = dictionary_encode_columns(table, {"symbol"});
+            int64_t start_offset = offset;
+            write_table_to_mmap(table, mmap, offset, preset);
+            int64_t table_size = offset - start_offset;
+            handle_status(mmap->Seek(sizeof(Metadata) + i * sizeof(int64_t)));
+            handle_status(mmap->Write(&table_size, sizeof(int64_t)));
+            std::cout << "Compressed table " << i + 1 << " size: " << table_size
+                      << " bytes" << std::endl;
+        }
+        handle_status(mmap->Close());
+        return 0;
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "--rotate") == 0) {
+        write_snapshots_rotating(total_size, rows_per_table);
+        return 0;
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "--hugepages") == 0) {
+        write_tables_hugepage(total_size, metadata_size, rows_per_table);
+        std::cout << "Wrote " << num_tables << " tables via huge-page mapping." << std::endl;
+        return 0;
+    }
+
     // Create memory mapped file
     auto maybe_mmap = arrow::io::MemoryMappedFile::Create(SHM_NAME, total_size);
     handle_status(maybe_mmap.status());
@@ -93,8 +582,9 @@ int main() {
         std::chrono::system_clock::now().time_since_epoch()
     ).count();
 
+    BuilderPool builders;
     for (int i = 0; i < num_tables; ++i) {
-        auto table = create_table(rows_per_table[i], current_time + i * 1000000000);
+        auto table = create_table(builders, rows_per_table[i], current_time + i * 1000000000);
         int64_t start_offset = offset;
         write_table_to_mmap(table, mmap, offset);
         int64_t table_size = offset - start_offset;
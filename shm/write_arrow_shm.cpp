@@ -5,10 +5,12 @@
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 #include <iostream>
+#include <atomic>
 #include <cstring>
 #include <vector>
 #include <random>
 #include <chrono>
+#include <thread>
 
 const char* SHM_NAME = "arrow_shm";
 
@@ -56,6 +58,144 @@ std::shared_ptr<arrow::Table> create_table(int num_rows, int64_t start_time) {
     return arrow::Table::Make(schema, {timestamp_array, price_array, volume_array});
 }
 
+// Reusable builder pool: constructs the three column builders once and
+// re-reserves capacity to the high-water row count at the start of each
+// cycle. Finish() moves the builders' buffers into the finished arrays, so
+// the builders come back empty with their capacity released; the up-front
+// Reserve replaces the log2(n) doubling reallocations that plain appends
+// would pay with one allocation per column per table, typically satisfied
+// from the memory pool's just-freed blocks.
+class BuilderPool {
+public:
+    explicit BuilderPool(arrow::MemoryPool* pool = arrow::default_memory_pool())
+        : timestamp_builder(pool), price_builder(pool), volume_builder(pool) {}
+
+    // Re-establish the reservation for the next cycle, growing the
+    // high-water mark to `num_rows`. Runs every cycle: Finish() released
+    // the previous buffers, so Reserve must be repeated even when
+    // num_rows has not grown (it is a no-op only while capacity is
+    // already sufficient).
+    void reserve(int64_t num_rows) {
+        if (num_rows > reserved_rows) {
+            reserved_rows = num_rows;
+        }
+        handle_status(timestamp_builder.Reserve(reserved_rows));
+        handle_status(price_builder.Reserve(reserved_rows));
+        handle_status(volume_builder.Reserve(reserved_rows));
+    }
+
+    arrow::Int64Builder timestamp_builder;
+    arrow::DoubleBuilder price_builder;
+    arrow::DoubleBuilder volume_builder;
+
+private:
+    int64_t reserved_rows = 0;
+};
+
+// create_table variant drawing from a caller-owned BuilderPool; the pool's
+// builders come back empty after Finish (their buffers now belong to the
+// finished arrays) and are re-reserved on the next call.
+std::shared_ptr<arrow::Table> create_table(BuilderPool& builders, int num_rows, int64_t start_time) {
+    builders.reserve(num_rows);
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> price_dist(100.0, 200.0);
+    std::uniform_real_distribution<> volume_dist(1000.0, 10000.0);
+
+    for (int i = 0; i < num_rows; ++i) {
+        handle_status(builders.timestamp_builder.Append(start_time + i * 1000000)); // Increment by 1ms
+        handle_status(builders.price_builder.Append(price_dist(gen)));
+        handle_status(builders.volume_builder.Append(volume_dist(gen)));
+    }
+
+    std::shared_ptr<arrow::Array> timestamp_array;
+    std::shared_ptr<arrow::Array> price_array;
+    std::shared_ptr<arrow::Array> volume_array;
+    handle_status(builders.timestamp_builder.Finish(&timestamp_array));
+    handle_status(builders.price_builder.Finish(&price_array));
+    handle_status(builders.volume_builder.Finish(&volume_array));
+
+    auto schema = arrow::schema({
+        arrow::field("timestamp_nano", arrow::int64()),
+        arrow::field("price", arrow::float64()),
+        arrow::field("volume", arrow::float64())
+    });
+
+    return arrow::Table::Make(schema, {timestamp_array, price_array, volume_array});
+}
+
+// Counter-based random stream: output is a pure function of (seed, counter),
+// so any batch of lanes can be computed independently — there is no serial
+// generator state like std::mt19937's 624-word twist to thread through the
+// loop. The mixer is splitmix64: cheap enough that the 8-lane inner loop
+// below auto-vectorizes into SIMD multiplies and shifts.
+struct CounterRng {
+    static uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Uniform double in [0, 1): top 53 bits of the mixed counter.
+    static double toUnit(uint64_t bits) {
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
+};
+
+// Columnar fill path: create_table above pays three virtual Append calls and
+// a serial RNG draw per row. Here each column is generated straight into an
+// Arrow-allocated (64-byte aligned) buffer in a counter-indexed loop the
+// vectorizer can unroll 8 lanes wide, and the buffers are adopted as arrays
+// without a single per-element call. This is the load-generator path for
+// throughput-testing the shm transport: table construction cost becomes
+// memory bandwidth, not builder overhead.
+std::shared_ptr<arrow::Table> create_table_columnar(int num_rows, int64_t start_time,
+                                                    uint64_t seed = 0xC0FFEE) {
+    auto alloc = [&](int64_t bytes) {
+        arrow::Result<std::unique_ptr<arrow::Buffer>> maybe = arrow::AllocateBuffer(bytes);
+        handle_status(maybe.status());
+        return std::shared_ptr<arrow::Buffer>(std::move(maybe).ValueOrDie());
+    };
+    std::shared_ptr<arrow::Buffer> timestamp_buf = alloc(num_rows * sizeof(int64_t));
+    std::shared_ptr<arrow::Buffer> price_buf = alloc(num_rows * sizeof(double));
+    std::shared_ptr<arrow::Buffer> volume_buf = alloc(num_rows * sizeof(double));
+
+    int64_t* timestamps = reinterpret_cast<int64_t*>(timestamp_buf->mutable_data());
+    double* prices = reinterpret_cast<double*>(price_buf->mutable_data());
+    double* volumes = reinterpret_cast<double*>(volume_buf->mutable_data());
+
+    for (int i = 0; i < num_rows; ++i) {
+        timestamps[i] = start_time + int64_t{i} * 1000000; // 1ms spacing
+    }
+    // Distinct seed offsets give price and volume independent streams over
+    // the same counters.
+    for (int i = 0; i < num_rows; ++i) {
+        prices[i] = 100.0 + 100.0 * CounterRng::toUnit(CounterRng::mix(seed + i));
+    }
+    for (int i = 0; i < num_rows; ++i) {
+        volumes[i] = 1000.0 + 9000.0 * CounterRng::toUnit(CounterRng::mix(~seed + i));
+    }
+
+    // Adopt the buffers directly; no builder, no copies, no validity bitmap
+    // (the columns are dense).
+    auto timestamp_array = arrow::MakeArray(
+        arrow::ArrayData::Make(arrow::int64(), num_rows, {nullptr, timestamp_buf}));
+    auto price_array = arrow::MakeArray(
+        arrow::ArrayData::Make(arrow::float64(), num_rows, {nullptr, price_buf}));
+    auto volume_array = arrow::MakeArray(
+        arrow::ArrayData::Make(arrow::float64(), num_rows, {nullptr, volume_buf}));
+
+    auto schema = arrow::schema({
+        arrow::field("timestamp_nano", arrow::int64()),
+        arrow::field("price", arrow::float64()),
+        arrow::field("volume", arrow::float64())
+    });
+
+    return arrow::Table::Make(schema, {timestamp_array, price_array, volume_array});
+}
+
 void write_table_to_buffer(const std::shared_ptr<arrow::Table>& table, char* buffer, int64_t& offset) {
     arrow::Result<std::shared_ptr<arrow::io::BufferOutputStream>> maybe_out_stream = 
         arrow::io::BufferOutputStream::Create(1024 * 1024, arrow::default_memory_pool());
@@ -79,9 +219,193 @@ void write_table_to_buffer(const std::shared_ptr<arrow::Table>& table, char* buf
     offset += buf->size();
 }
 
-int main() {
+// Header for the streaming layout: a seqlock-versioned watermark telling
+// readers how many bytes of the IPC stream are committed. The writer bumps
+// `sequence` to an odd value before moving the watermark and back to even
+// after; a reader that sees an odd sequence, or a sequence that changed
+// across its read, retries. Readers may consume record batches up to
+// `committed_bytes` while the writer keeps appending behind them.
+struct StreamingHeader {
+    std::atomic<uint64_t> sequence;
+    int64_t committed_bytes;
+    int32_t num_batches;
+};
+
+static void commit_watermark(StreamingHeader* header, int64_t committed, int32_t batches) {
+    const uint64_t seq = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(seq + 1, std::memory_order_release); // Odd: write in progress
+    header->committed_bytes = committed;
+    header->num_batches = batches;
+    header->sequence.store(seq + 2, std::memory_order_release); // Even: consistent
+}
+
+// Streaming append mode: record batches are serialized straight into the
+// mapped region through a FixedSizeBufferWriter as they are produced — no
+// intermediate BufferOutputStream and no final memcpy, so peak memory stays
+// at 1x the data and readers see each batch as soon as its watermark commits.
+void stream_tables_to_shm(char* mem, int64_t data_capacity) {
+    StreamingHeader* header = reinterpret_cast<StreamingHeader*>(mem);
+    new (header) StreamingHeader{};
+    char* data = mem + sizeof(StreamingHeader);
+
+    auto buffer = std::make_shared<arrow::MutableBuffer>(
+        reinterpret_cast<uint8_t*>(data), data_capacity);
+    arrow::io::FixedSizeBufferWriter sink(buffer);
+
+    auto schema = arrow::schema({
+        arrow::field("timestamp_nano", arrow::int64()),
+        arrow::field("price", arrow::float64()),
+        arrow::field("volume", arrow::float64())
+    });
+
+    arrow::ipc::IpcWriteOptions options = arrow::ipc::IpcWriteOptions::Defaults();
+    auto maybe_writer = arrow::ipc::MakeStreamWriter(&sink, schema, options);
+    handle_status(maybe_writer.status());
+    auto writer = maybe_writer.ValueOrDie();
+
+    int64_t current_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+
+    // Publish one batch per "minute bar" as it is produced; a real feed
+    // would loop forever, the demo emits a handful.
+    const int num_batches = 5;
+    BuilderPool builders;
+    for (int i = 0; i < num_batches; ++i) {
+        auto table = create_table(builders, 4, current_time + i * 1000000000);
+        arrow::TableBatchReader batch_reader(*table);
+        std::shared_ptr<arrow::RecordBatch> batch;
+        handle_status(batch_reader.ReadNext(&batch));
+        handle_status(writer->WriteRecordBatch(*batch));
+
+        // Everything up to Tell() is fully serialized; advertise it.
+        commit_watermark(header, sink.Tell().ValueOrDie(), i + 1);
+        std::cout << "Committed batch " << i + 1 << " at watermark "
+                  << header->committed_bytes << " bytes" << std::endl;
+    }
+    handle_status(writer->Close());
+    commit_watermark(header, sink.Tell().ValueOrDie(), num_batches);
+}
+
+// Double-buffered snapshot layout: two table regions plus an atomically
+// published active index, with a seqlock-style version word. The writer
+// bumps `version` to an odd value *before* it starts overwriting the
+// inactive region — a reader still draining the previous snapshot out of
+// that region must see the version move — then serializes, flips
+// `active_index` with a release store, and bumps `version` again to even.
+// Readers: load the version (retry while odd), load the index with
+// acquire, read the region, and re-check that the version is unchanged;
+// any movement means the writer touched a region mid-read, so retry.
+// No torn reads, no reader stalls during publication.
+struct DoubleBufferedHeader {
+    std::atomic<uint64_t> version;     // Odd while a fill is in progress
+    std::atomic<uint32_t> active_index; // 0 or 1: which region is current
+    int64_t table_size_bytes[2];
+};
+
+void publish_double_buffered(char* mem, int64_t region_capacity, int num_publishes) {
+    DoubleBufferedHeader* header = reinterpret_cast<DoubleBufferedHeader*>(mem);
+    new (header) DoubleBufferedHeader{};
+    char* regions[2] = {
+        mem + sizeof(DoubleBufferedHeader),
+        mem + sizeof(DoubleBufferedHeader) + region_capacity,
+    };
+
+    BuilderPool builders;
+    int64_t current_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+
+    for (int i = 0; i < num_publishes; ++i) {
+        // Announce the fill before touching any bytes (version goes odd):
+        // the inactive region was the *active* one a publish ago, and a
+        // slow reader may still be copying out of it.
+        header->version.fetch_add(1, std::memory_order_release);
+
+        // Fill the buffer readers are NOT (supposed to be) looking at.
+        const uint32_t inactive = 1 - header->active_index.load(std::memory_order_relaxed);
+        auto table = create_table(builders, 5, current_time + i * 1000000000);
+        int64_t offset = 0;
+        write_table_to_buffer(table, regions[inactive], offset);
+        header->table_size_bytes[inactive] = offset;
+
+        // Publish: flip the active index, then return the version to even.
+        // The release stores order the table bytes before the index and
+        // the index before the version for readers.
+        header->active_index.store(inactive, std::memory_order_release);
+        header->version.fetch_add(1, std::memory_order_release);
+        std::cout << "Published snapshot " << i + 1 << " into region "
+                  << inactive << " (" << offset << " bytes)" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
     using namespace boost::interprocess;
 
+    if (argc > 1 && std::strcmp(argv[1], "--loadgen") == 0) {
+        // Throughput harness: columnar generation vs the row-at-a-time
+        // builder loop, then one serialized pass into shared memory.
+        const int num_rows = argc > 2 ? std::atoi(argv[2]) : 1000000;
+        int64_t current_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+
+        auto t0 = std::chrono::steady_clock::now();
+        auto columnar = create_table_columnar(num_rows, current_time);
+        auto t1 = std::chrono::steady_clock::now();
+        auto rowwise = create_table(num_rows, current_time);
+        auto t2 = std::chrono::steady_clock::now();
+
+        const auto columnar_us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        const auto rowwise_us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+        std::cout << num_rows << " rows: columnar fill " << columnar_us
+                  << " us, builder loop " << rowwise_us << " us" << std::endl;
+
+        const int64_t total_size = sizeof(Metadata) + num_rows * 3 * 8 + (1 << 20);
+        shared_memory_object::remove(SHM_NAME);
+        shared_memory_object shm(create_only, SHM_NAME, read_write);
+        shm.truncate(total_size);
+        mapped_region region(shm, read_write);
+        char* mem = static_cast<char*>(region.get_address());
+        Metadata* metadata = reinterpret_cast<Metadata*>(mem);
+        metadata->num_tables = 1;
+
+        int64_t offset = 0;
+        auto t3 = std::chrono::steady_clock::now();
+        write_table_to_buffer(columnar, mem + sizeof(Metadata), offset);
+        auto t4 = std::chrono::steady_clock::now();
+        metadata->table_size_bytes[0] = offset;
+        const auto write_us = std::chrono::duration_cast<std::chrono::microseconds>(t4 - t3).count();
+        std::cout << "Serialized " << offset << " bytes to shm in " << write_us
+                  << " us (" << (offset / 1048576.0) / (write_us / 1e6)
+                  << " MiB/s)" << std::endl;
+        return 0;
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "--double-buffer") == 0) {
+        const int64_t region_capacity = 1024 * 1024;
+        const int64_t total_size = sizeof(DoubleBufferedHeader) + 2 * region_capacity;
+        shared_memory_object::remove(SHM_NAME);
+        shared_memory_object shm(create_only, SHM_NAME, read_write);
+        shm.truncate(total_size);
+        mapped_region region(shm, read_write);
+        publish_double_buffered(static_cast<char*>(region.get_address()),
+                                region_capacity, 5);
+        return 0;
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "--stream") == 0) {
+        const int64_t total_size = sizeof(StreamingHeader) + 4 * 1024 * 1024;
+        shared_memory_object::remove(SHM_NAME);
+        shared_memory_object shm(create_only, SHM_NAME, read_write);
+        shm.truncate(total_size);
+        mapped_region region(shm, read_write);
+        stream_tables_to_shm(static_cast<char*>(region.get_address()),
+                             total_size - sizeof(StreamingHeader));
+        std::cout << "Streamed batches to shared memory." << std::endl;
+        return 0;
+    }
+
     const int num_tables = 3;
     const std::vector<int> rows_per_table = {3, 4, 5};  // Variable number of rows
 
@@ -108,8 +432,9 @@ int main() {
         std::chrono::system_clock::now().time_since_epoch()
     ).count();
 
+    BuilderPool builders;
     for (int i = 0; i < num_tables; ++i) {
-        auto table = create_table(rows_per_table[i], current_time + i * 1000000000);
+        auto table = create_table(builders, rows_per_table[i], current_time + i * 1000000000);
         int64_t start_offset = offset;
         write_table_to_buffer(table, data_buffer, offset);
         metadata->table_size_bytes[i] = offset - start_offset;
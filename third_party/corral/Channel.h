@@ -24,7 +24,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <optional>
+#include <span>
 
 #include "config.h"
 #include "detail/ParkingLot.h"
@@ -52,6 +55,39 @@ class ReadHalf : public corral::detail::ParkingLotImpl<ReadHalf<T>> {
         return static_cast<const Channel<T>&>(*this);
     }
 
+    struct ReadBatchAwaitable : public ReadHalf::ParkingLotImpl::Parked {
+        using Base = typename ReadHalf::ParkingLotImpl::Parked;
+
+        ReadBatchAwaitable(ReadHalf& self, T* out, size_t maxCount)
+          : Base(self), out_(out), maxCount_(maxCount) {}
+
+        bool await_ready() const noexcept {
+            return !channel().empty() || channel().closed();
+        }
+
+        void await_suspend(corral::Handle h) {
+            CORRAL_TRACE("    ...channel %p receiveBatch %p", &channel(), this);
+            this->doSuspend(h);
+        }
+
+        size_t await_resume() {
+            return channel().tryReceiveBatch(out_, maxCount_);
+        }
+
+        using Base::await_cancel;
+
+      private:
+        Channel<T>& channel() {
+            return static_cast<Channel<T>&>(Base::object());
+        }
+        const Channel<T>& channel() const {
+            return static_cast<const Channel<T>&>(Base::object());
+        }
+
+        T* out_;
+        size_t maxCount_;
+    };
+
     struct ReadAwaitable : public ReadHalf::ParkingLotImpl::Parked {
         using Base = typename ReadHalf::ParkingLotImpl::Parked;
 
@@ -93,6 +129,30 @@ class ReadHalf : public corral::detail::ParkingLotImpl<ReadHalf<T>> {
         return data;
     }
 
+    /// Retrieve up to `maxCount` objects into `out` in one buffer pass,
+    /// suspending at most once (only if the channel is empty and not
+    /// closed). Returns the number of objects received; zero means the
+    /// channel is closed and drained.
+    corral::Awaitable<size_t> auto receiveBatch(T* out, size_t maxCount) {
+        return ReadBatchAwaitable(*this, out, maxCount);
+    }
+
+    /// Like receiveBatch(), but never suspends: moves out whatever is
+    /// immediately available (possibly nothing).
+    size_t tryReceiveBatch(T* out, size_t maxCount) {
+        const size_t count = std::min(maxCount, channel().size());
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = std::move(channel().buf_.front());
+            channel().buf_.pop_front();
+        }
+        // One writer slot opened per object received, as tryReceive() would
+        // have done item by item.
+        for (size_t i = 0; i < count; ++i) {
+            this->channel().writeHalf().unparkOne();
+        }
+        return count;
+    }
+
     size_t size() const noexcept { return channel().size(); }
     bool empty() const noexcept { return channel().empty(); }
     bool closed() const noexcept { return channel().closed(); }
@@ -121,6 +181,36 @@ class WriteHalf : public corral::detail::ParkingLotImpl<WriteHalf<T>> {
         return static_cast<const Channel<T>&>(*this);
     }
 
+    struct WriteBatchAwaitable : public WriteHalf::ParkingLotImpl::Parked {
+        using Base = typename WriteHalf::ParkingLotImpl::Parked;
+
+        WriteBatchAwaitable(WriteHalf& self, std::span<T> values)
+          : Base(self), values_(values) {}
+
+        bool await_ready() const noexcept {
+            return channel().closed() || !channel().full();
+        }
+
+        void await_suspend(corral::Handle h) {
+            CORRAL_TRACE("    ...channel %p sendBatch %p", &channel(), this);
+            this->doSuspend(h);
+        }
+
+        size_t await_resume() { return channel().trySendBatch(values_); }
+
+        using Base::await_cancel;
+
+      private:
+        Channel<T>& channel() {
+            return static_cast<Channel<T>&>(Base::object());
+        }
+        const Channel<T>& channel() const {
+            return static_cast<const Channel<T>&>(Base::object());
+        }
+
+        std::span<T> values_;
+    };
+
     template <typename U>
     struct WriteAwaitable : public WriteHalf::ParkingLotImpl::Parked {
         using Base = typename WriteHalf::ParkingLotImpl::Parked;
@@ -169,6 +259,33 @@ class WriteHalf : public corral::detail::ParkingLotImpl<WriteHalf<T>> {
     }
     void close() { channel().close(); }
 
+    /// Move as many elements of `values` into the channel as fit in one
+    /// buffer pass, suspending at most once (only if the buffer is full
+    /// and the channel is open). Returns the number of elements moved
+    /// from; the caller owns any unsent tail. Zero means the channel is
+    /// closed (or was still full after the single wakeup).
+    corral::Awaitable<size_t> auto sendBatch(std::span<T> values) {
+        return WriteBatchAwaitable(*this, values);
+    }
+
+    /// Like sendBatch(), but never suspends: moves in whatever fits
+    /// immediately (possibly nothing).
+    size_t trySendBatch(std::span<T> values) {
+        if (channel().closed()) {
+            return 0;
+        }
+        const size_t count = std::min(values.size(), channel().space());
+        for (size_t i = 0; i < count; ++i) {
+            channel().buf_.push_back(std::move(values[i]));
+        }
+        // One reader woken per object delivered, as trySend() would have
+        // done item by item.
+        for (size_t i = 0; i < count; ++i) {
+            channel().readHalf().unparkOne();
+        }
+        return count;
+    }
+
     size_t space() const noexcept { return channel().space(); }
     bool full() const noexcept { return channel().full(); }
     bool closed() const noexcept { return channel().closed(); }
@@ -307,6 +424,19 @@ struct Channel : public detail::channel::ReadHalf<T>,
     /// if none are immediately available.
     std::optional<T> tryReceive() { return readHalf().tryReceive(); }
 
+    /// Retrieve up to `maxCount` objects in one buffer pass with at most
+    /// one suspension. Returns the number received; zero means the channel
+    /// is closed and drained.
+    corral::Awaitable<size_t> auto receiveBatch(T* out, size_t maxCount) {
+        return readHalf().receiveBatch(out, maxCount);
+    }
+
+    /// Retrieve whatever objects are immediately available, up to
+    /// `maxCount`, without suspending.
+    size_t tryReceiveBatch(T* out, size_t maxCount) {
+        return readHalf().tryReceiveBatch(out, maxCount);
+    }
+
     /// A reference to this channel that only exposes the operations that
     /// would be needed by a writer: send(), trySend(), close(), space(),
     /// full(), and closed().
@@ -331,6 +461,19 @@ struct Channel : public detail::channel::ReadHalf<T>,
         return writeHalf().trySend(std::forward<U>(value));
     }
 
+    /// Deliver as many elements of `values` as fit in one buffer pass with
+    /// at most one suspension. Returns the number moved from; the caller
+    /// owns any unsent tail.
+    corral::Awaitable<size_t> auto sendBatch(std::span<T> values) {
+        return writeHalf().sendBatch(values);
+    }
+
+    /// Deliver whatever elements of `values` fit immediately, without
+    /// suspending.
+    size_t trySendBatch(std::span<T> values) {
+        return writeHalf().trySendBatch(values);
+    }
+
   protected:
     friend ReadHalf;
     friend WriteHalf;
@@ -34,6 +34,7 @@
 #include "defs.h"
 #include "detail/Queue.h"
 #include "detail/ScopeGuard.h"
+#include "detail/TimerWheel.h"
 #include "detail/platform.h"
 #include "detail/utility.h"
 
@@ -46,6 +47,19 @@ concept RootAwaitable = Introspectable<Aw> || ImmediateAwaitable<Aw>;
 
 }
 
+/// Scheduling lane for callbacks submitted to an Executor. Lower values
+/// drain first: within one executor run, everything pending in the High
+/// lane runs before anything in the Normal lane, and Normal before Low.
+/// Within a lane, FIFO order is preserved. Since the executor re-picks
+/// the highest non-empty lane after every callback, a High submission
+/// made while Low work is draining preempts the rest of that work at
+/// the very next suspension point.
+///
+/// A task's lane is normally inherited from the nursery that spawned it
+/// (see Nursery::setPriority()); submissions that don't name a lane
+/// inherit the lane of the callback currently running.
+enum class Priority : uint8_t { High = 0, Normal = 1, Low = 2 };
+
 /// A lightweight executor for coroutine resumptions and other actions
 /// that corral might need to defer for a short time.
 ///
@@ -81,6 +95,11 @@ concept RootAwaitable = Introspectable<Aw> || ImmediateAwaitable<Aw>;
 /// you call a synchronous function that happens to internally do another
 /// `corral::run()`.)
 ///
+/// Ready callbacks live in one queue per `Priority` lane, drained
+/// strictly (High before Normal before Low, re-picked after every
+/// callback); see `Priority` for details. Submissions that don't name
+/// a lane inherit the lane of the callback currently running.
+///
 /// The basic pattern used when submitting to the executor is to write
 /// `executor->runSoon(<thing>)`. This will run the `<thing>` immediately
 /// if there is not another executor callback currently running for the same
@@ -90,6 +109,7 @@ concept RootAwaitable = Introspectable<Aw> || ImmediateAwaitable<Aw>;
 class Executor {
     using Task = std::pair<void (*)(void*) noexcept, void*>;
     using Tasks = detail::Queue<Task>;
+    static constexpr const size_t NumLanes = 3;
 
   public:
     struct Capacity {
@@ -112,7 +132,8 @@ class Executor {
     explicit Executor(EventLoopID eventLoopID,
                       std::nullptr_t,
                       size_t capacity = Capacity::Default)
-      : eventLoopID_(eventLoopID), buffer_(capacity) {}
+      : eventLoopID_(eventLoopID),
+        lanes_{Tasks(capacity), Tasks(capacity), Tasks(capacity)} {}
 
     template <class EventLoopT>
     explicit Executor(EventLoopT&& eventLoop,
@@ -142,7 +163,9 @@ class Executor {
         // soon.
         CORRAL_ASSERT(!scheduled_);
 
-        CORRAL_ASSERT(buffer_.empty());
+        for (Tasks& lane : lanes_) {
+            CORRAL_ASSERT(lane.empty());
+        }
         if (running_ != nullptr) {
             *running_ = false;
         }
@@ -159,9 +182,38 @@ class Executor {
         runSoon();
     }
 
+    /// Same, submitting into an explicit priority lane.
+    template <class T>
+    void runSoon(void (*fn)(T*) noexcept, T* arg, Priority priority) {
+        schedule(fn, arg, priority);
+        runSoon();
+    }
+
     /// Runs executor loop until it's empty.
     /// This function is reenterant.
-    void drain() { drain(*ready_); }
+    void drain() { drainLanes(); }
+
+    /// The timer wheel backing sleepFor()/sleepUntil() (see Timer.h).
+    /// Timers fire only when runDueTimers() is called; an event loop
+    /// should call it when it wakes up, using nextTimerDeadline() to
+    /// bound how long it blocks.
+    detail::TimerWheel& timers() noexcept { return timers_; }
+
+    /// Fires every timer due by now (each one schedules its wakeup onto
+    /// this executor), then runs the loop if anything fired. Returns the
+    /// number of timers fired.
+    size_t runDueTimers() {
+        size_t fired = timers_.runDue(detail::TimerWheel::Clock::now());
+        if (fired > 0) {
+            runSoon();
+        }
+        return fired;
+    }
+
+    /// Earliest pending timer deadline, or time_point::max() if none.
+    detail::TimerWheel::Clock::time_point nextTimerDeadline() const {
+        return timers_.nextDeadline();
+    }
 
     /// Arranges `fn(arg)` to be called on the next executor loop,
     /// but does *not* run the executor loop.
@@ -170,11 +222,44 @@ class Executor {
     /// in the future, or else the callback will never be called.
     ///
     /// This is an advanced interface that should be used with care.
+    ///
+    /// Without an explicit priority, the submission inherits the lane of
+    /// the callback currently running (Normal if the executor is idle),
+    /// so follow-up work scheduled by a High task stays High.
     template <class T> void schedule(void (*fn)(T*) noexcept, T* arg) {
-        ready_->emplace_back(reinterpret_cast<void (*)(void*) noexcept>(fn),
-                             arg);
+        schedule(fn, arg, runningPriority_);
+    }
+
+    /// Same, submitting into an explicit priority lane.
+    template <class T>
+    void schedule(void (*fn)(T*) noexcept, T* arg, Priority priority) {
+        Tasks& tasks =
+                captured_ ? *captured_ : lanes_[static_cast<size_t>(priority)];
+        tasks.emplace_back(reinterpret_cast<void (*)(void*) noexcept>(fn),
+                           arg);
+    }
+
+    /// Deadline-tagged submission: the callback must run by `deadline`.
+    /// It always takes the High lane, so it preempts any batch work still
+    /// pending in lower lanes at the next suspension point; the deadline
+    /// itself is used to flag submissions that are already late (usually
+    /// a sign the High lane is oversubscribed).
+    template <class T>
+    void schedule(void (*fn)(T*) noexcept,
+                  T* arg,
+                  detail::TimerWheel::Clock::time_point deadline) {
+        if (deadline < detail::TimerWheel::Clock::now()) {
+            CORRAL_TRACE("executor %p: deadline-tagged callback already late",
+                         this);
+        }
+        schedule(fn, arg, Priority::High);
     }
 
+    /// The lane of the callback currently being run by this executor,
+    /// or Normal if it is idle. New submissions without an explicit
+    /// priority land in this lane.
+    Priority currentPriority() const noexcept { return runningPriority_; }
+
     /// Runs executor loop.
     /// If called from within the loop, does nothing; if called from another
     /// executor's loop, schedules this executor's event loop to be run
@@ -205,9 +290,9 @@ class Executor {
         Tasks tmp{capacity};
         detail::ScopeGuard guard([&] { drain(tmp); });
 
-        Tasks* oldReady = ready_;
-        ready_ = &tmp;
-        detail::ScopeGuard guard2([&] { ready_ = oldReady; });
+        Tasks* oldCaptured = captured_;
+        captured_ = &tmp;
+        detail::ScopeGuard guard2([&] { captured_ = oldCaptured; });
 
         fn();
     }
@@ -218,6 +303,17 @@ class Executor {
         }
     }
 
+    /// Registers a hook invoked after each callback the executor runs --
+    /// i.e., at points where no coroutine is mid-step and the task tree
+    /// is consistent, so the hook may safely walk it. Used by TaskSampler
+    /// (see Sampler.h) to capture await-point samples; the hook must be
+    /// cheap when it has nothing to do, since it runs once per callback.
+    /// Pass nullptr to remove a previously installed hook.
+    void setSampleHook(void (*fn)(void*) noexcept, void* arg) noexcept {
+        sampleHook_ = fn;
+        sampleHookArg_ = arg;
+    }
+
     /// Save a `std::coroutine_handle` for the task that is currently running
     /// on the CPU.
     ///
@@ -268,7 +364,32 @@ class Executor {
         }
     }
 
+    /// Drains a single list of tasks in FIFO order (used by capture()).
     void drain(Tasks& tasks) noexcept {
+        drainImpl([&tasks]() noexcept -> Tasks* {
+            return tasks.empty() ? nullptr : &tasks;
+        });
+    }
+
+    /// Drains the priority lanes, strictly: the highest non-empty lane is
+    /// re-picked after every callback, so a High resume submitted mid-drain
+    /// runs before any remaining Normal or Low work.
+    void drainLanes() noexcept {
+        drainImpl([this]() noexcept -> Tasks* {
+            for (size_t i = 0; i < NumLanes; ++i) {
+                if (!lanes_[i].empty()) {
+                    runningPriority_ = static_cast<Priority>(i);
+                    return &lanes_[i];
+                }
+            }
+            runningPriority_ = Priority::Normal;
+            return nullptr;
+        });
+    }
+
+    /// `nextLane()` picks the queue to pop the next task from, or returns
+    /// nullptr when there is nothing left to run.
+    template <class NextLaneFn> void drainImpl(NextLaneFn nextLane) noexcept {
         Executor* prev = current();
         current() = this;
         detail::ScopeGuard guard([&] { current() = prev; });
@@ -284,10 +405,17 @@ class Executor {
             }
         });
 
-        while (*running && !tasks.empty()) {
-            auto [fn, arg] = tasks.front();
-            tasks.pop_front();
+        Tasks* tasks;
+        while (*running && (tasks = nextLane()) != nullptr) {
+            auto [fn, arg] = tasks->front();
+            tasks->pop_front();
             fn(arg);
+            // The callback has returned, so every coroutine is suspended
+            // at an await point: safe to snapshot the task tree. (`*running`
+            // guards against the executor having been destroyed by fn().)
+            if (*running && sampleHook_ != nullptr) {
+                sampleHook_(sampleHookArg_);
+            }
         }
     }
 
@@ -306,12 +434,20 @@ class Executor {
 
   private:
     EventLoopID eventLoopID_;
-    Tasks buffer_;
+
+    /// Ready tasks, one queue per Priority value; lower indices drain
+    /// first. Fixed storage per lane, so a fully drained lane costs
+    /// nothing but an empty() check.
+    Tasks lanes_[NumLanes];
     Handle active_;
 
-    /// Currently used list of ready tasks. Normally points to buffer_,
-    /// but can be temporarily replaced from capture().
-    Tasks* ready_ = &buffer_;
+    /// Non-null while capture() is redirecting submissions into its
+    /// temporary list; takes precedence over the priority lanes.
+    Tasks* captured_ = nullptr;
+
+    /// Lane of the callback currently running; inherited by submissions
+    /// that don't name a lane explicitly.
+    Priority runningPriority_ = Priority::Normal;
 
     bool* running_ = nullptr;
 
@@ -319,6 +455,12 @@ class Executor {
     /// in near future.
     bool scheduled_ = false;
 
+    /// Invoked between executor callbacks when set; see setSampleHook().
+    void (*sampleHook_)(void*) noexcept = nullptr;
+    void* sampleHookArg_ = nullptr;
+
+    detail::TimerWheel timers_;
+
     const void* rootAwaitable_ = nullptr;
     void (*collectTaskTree_)(const void* root,
                              detail::TaskTreeCollector&) noexcept = nullptr;
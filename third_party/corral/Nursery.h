@@ -119,6 +119,12 @@ class Nursery : private detail::TaskParent<void> {
     /// Requests cancellation of all tasks.
     void cancel();
 
+    /// Sets the executor priority lane for tasks subsequently started in
+    /// this nursery (see corral::Priority). Tasks already running keep
+    /// the lane they were spawned with. Defaults to Normal.
+    void setPriority(Priority priority) noexcept { priority_ = priority; }
+    Priority priority() const noexcept { return priority_; }
+
     /// Returns the executor for this nursery. This may be nullptr if the
     /// nursery is closed (meaning no new tasks can be started in it).
     Executor* executor() const noexcept { return executor_; }
@@ -150,6 +156,7 @@ class Nursery : private detail::TaskParent<void> {
     Executor* executor_ = nullptr;
     detail::IntrusiveList<detail::BasePromise> tasks_;
     size_t taskCount_ = 0;
+    Priority priority_ = Priority::Normal;
     Handle parent_ = nullptr;
     std::exception_ptr exception_;
 };
@@ -317,6 +324,7 @@ inline Handle Nursery::addTask(Task<Ret> task, TaskParent<Ret>* parent) {
     tasks_.push_back(*promise);
     ++taskCount_;
     promise->setExecutor(executor_);
+    promise->setPriority(priority_);
     return promise->start(parent, parent_);
 }
 
@@ -0,0 +1,310 @@
+// This file is part of corral, a lightweight C++20 coroutine library.
+//
+// Copyright (c) 2024 Hudson River Trading LLC <opensource@hudson-trading.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <typeinfo>
+
+#include "Executor.h"
+#include "detail/introspect.h"
+
+namespace corral {
+
+/// A lightweight fingerprint of one node on a root-to-leaf path of the
+/// task tree: the suspended-at program counter for async function frames,
+/// or an identity pointer (static name string or type_info) for awaitables.
+/// Every representation is a stable address, so frames can be compared and
+/// aggregated long after the coroutines they describe have completed.
+struct SampleFrame {
+    enum class Kind : uint8_t { Pc, Name, Type };
+    uintptr_t value;
+    Kind kind;
+};
+
+/// Sampling profiler for the await states of a running executor.
+///
+/// dumpTaskTree() renders the full tree synchronously, which is too
+/// expensive to call on a schedule in production. TaskSampler splits the
+/// work across the safe points the executor already has: requestSample()
+/// is a single relaxed atomic store (async-signal-safe, so a SIGPROF or
+/// timer_create handler may call it directly -- or use SamplingTicker
+/// below), and the actual tree walk happens on the executor thread via
+/// its sample hook, between two callbacks, when every coroutine is parked
+/// at an await point and the tree is consistent. Each captured sample is
+/// the set of root-to-leaf fingerprint paths, pushed into a fixed-size
+/// SPSC ring; a consumer thread drains the ring at its leisure (see
+/// FlamegraphAggregator). When disarmed the per-callback cost is one
+/// relaxed load, so continuous profiling at modest rates stays well under
+/// a percent of executor throughput.
+class TaskSampler {
+  public:
+    /// Paths deeper than this are truncated (leaf-most frames dropped);
+    /// flamegraph aggregation degrades gracefully on truncation.
+    static constexpr size_t MaxDepth = 16;
+
+    /// One root-to-leaf await path, root first.
+    struct Sample {
+        uint32_t size;
+        SampleFrame frames[MaxDepth];
+    };
+
+    /// `ringSize` bounds how many samples may sit undrained before new
+    /// ones are dropped (and counted); must be a power of two.
+    explicit TaskSampler(size_t ringSize = 1024)
+      : capacity_(ringSize), ring_(new Sample[ringSize]) {
+        CORRAL_ASSERT((ringSize & (ringSize - 1)) == 0);
+    }
+
+    ~TaskSampler() { detach(); }
+
+    TaskSampler(const TaskSampler&) = delete;
+    TaskSampler& operator=(const TaskSampler&) = delete;
+
+    /// Installs this sampler as `executor`'s sample hook. The sampler
+    /// must outlive the executor or be detach()ed first.
+    void attach(Executor& executor) noexcept {
+        executor_ = &executor;
+        executor.setSampleHook(
+                +[](void* self) noexcept {
+                    auto* sampler = static_cast<TaskSampler*>(self);
+                    if (sampler->pending_.load(std::memory_order_relaxed)) {
+                        sampler->collectNow();
+                    }
+                },
+                this);
+    }
+
+    void detach() noexcept {
+        if (executor_ != nullptr) {
+            executor_->setSampleHook(nullptr, nullptr);
+            executor_ = nullptr;
+        }
+    }
+
+    /// Arms the sampler: the next executor safe point will capture one
+    /// sample. A single relaxed store; safe to call from a signal
+    /// handler or any thread.
+    void requestSample() noexcept {
+        pending_.store(true, std::memory_order_relaxed);
+    }
+
+    /// Consumer side: pops every sample currently in the ring, invoking
+    /// `fn(const Sample&)` on each. Call from one thread only.
+    template <class Fn> size_t drainSamples(Fn&& fn) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        size_t popped = 0;
+        while (tail != head) {
+            fn(static_cast<const Sample&>(ring_[tail & (capacity_ - 1)]));
+            ++tail;
+            ++popped;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return popped;
+    }
+
+    /// Samples discarded because the ring was full (drain too slowly,
+    /// or sample faster).
+    uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    /// Walk state for one capture: the task tree arrives as a pre-order
+    /// stream of (fingerprint, depth) pairs, so a node is a leaf exactly
+    /// when the next node's depth does not exceed it (or the stream ends).
+    struct WalkState {
+        TaskSampler* self;
+        SampleFrame path[MaxDepth];
+        int lastDepth = -1;
+
+        void add(const TreeDumpElement& elt) {
+            if (elt.depth <= lastDepth) {
+                flushLeaf();
+            }
+            if (elt.depth < static_cast<int>(MaxDepth)) {
+                path[elt.depth] = toFrame(elt);
+            }
+            lastDepth = elt.depth;
+        }
+
+        void flushLeaf() {
+            if (lastDepth >= 0) {
+                self->pushSample(path,
+                                 std::min(static_cast<size_t>(lastDepth) + 1,
+                                          MaxDepth));
+            }
+        }
+
+        static SampleFrame toFrame(const TreeDumpElement& elt) {
+            if (const uintptr_t* pc = std::get_if<uintptr_t>(&elt.value)) {
+                return {*pc, SampleFrame::Kind::Pc};
+            }
+            if (const char* const* name = std::get_if<const char*>(&elt.value)) {
+                return {reinterpret_cast<uintptr_t>(*name),
+                        SampleFrame::Kind::Name};
+            }
+            return {reinterpret_cast<uintptr_t>(
+                            std::get<const std::type_info*>(elt.value)),
+                    SampleFrame::Kind::Type};
+        }
+    };
+
+    /// Runs on the executor thread, at a safe point between callbacks.
+    void collectNow() noexcept {
+        pending_.store(false, std::memory_order_relaxed);
+        WalkState state{this};
+        detail::TaskTreeCollector collector(
+                +[](void* cookie, TreeDumpElement elt) {
+                    static_cast<WalkState*>(cookie)->add(elt);
+                },
+                &state);
+        executor_->collectTaskTree(collector);
+        state.flushLeaf();
+    }
+
+    /// Producer side of the SPSC ring; drops (and counts) on overflow
+    /// rather than ever blocking the executor thread.
+    void pushSample(const SampleFrame* frames, size_t count) noexcept {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == capacity_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Sample& slot = ring_[head & (capacity_ - 1)];
+        slot.size = static_cast<uint32_t>(count);
+        for (size_t i = 0; i < count; ++i) {
+            slot.frames[i] = frames[i];
+        }
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    Executor* executor_ = nullptr;
+    std::atomic<bool> pending_{false};
+
+    const size_t capacity_;
+    std::unique_ptr<Sample[]> ring_;
+    std::atomic<size_t> head_{0};
+    std::atomic<size_t> tail_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+/// Arms a TaskSampler at a fixed interval from a background thread.
+/// This is the portable driver; on POSIX systems a setitimer(ITIMER_PROF)
+/// handler calling requestSample() achieves the same with CPU-time-based
+/// pacing, since requestSample() is async-signal-safe.
+class SamplingTicker {
+  public:
+    SamplingTicker(TaskSampler& sampler, std::chrono::microseconds interval)
+      : sampler_(sampler), interval_(interval), thread_([this] { run(); }) {}
+
+    ~SamplingTicker() {
+        stop_.store(true, std::memory_order_relaxed);
+        thread_.join();
+    }
+
+    SamplingTicker(const SamplingTicker&) = delete;
+    SamplingTicker& operator=(const SamplingTicker&) = delete;
+
+  private:
+    void run() {
+        while (!stop_.load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_for(interval_);
+            sampler_.requestSample();
+        }
+    }
+
+    TaskSampler& sampler_;
+    std::chrono::microseconds interval_;
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+/// Folds drained samples into flamegraph.pl "folded stacks" form: one
+/// "frame;frame;...;frame count" line per distinct root-to-leaf path,
+/// ready for `flamegraph.pl < folded.txt > out.svg`. PC frames render as
+/// hex addresses (symbolize with addr2line against the unstripped
+/// binary); awaitable frames render as their introspection name or
+/// mangled type name.
+class FlamegraphAggregator {
+  public:
+    /// Drains everything currently in `sampler`'s ring into the counts.
+    /// Call from the same thread each time (it is the ring's consumer).
+    size_t consume(TaskSampler& sampler) {
+        return sampler.drainSamples([this](const TaskSampler::Sample& sample) {
+            std::string key;
+            for (uint32_t i = 0; i < sample.size; ++i) {
+                if (i != 0) {
+                    key += ';';
+                }
+                appendFrame(key, sample.frames[i]);
+            }
+            ++counts_[key];
+            ++total_;
+        });
+    }
+
+    void writeFolded(std::ostream& out) const {
+        for (const auto& [stack, count] : counts_) {
+            out << stack << ' ' << count << '\n';
+        }
+    }
+
+    size_t distinctStacks() const noexcept { return counts_.size(); }
+    uint64_t totalSamples() const noexcept { return total_; }
+
+  private:
+    static void appendFrame(std::string& out, const SampleFrame& frame) {
+        switch (frame.kind) {
+            case SampleFrame::Kind::Pc: {
+                char buf[2 + sizeof(uintptr_t) * 2 + 1];
+                std::snprintf(buf, sizeof(buf), "0x%zx",
+                              static_cast<size_t>(frame.value));
+                out += buf;
+                break;
+            }
+            case SampleFrame::Kind::Name:
+                out += reinterpret_cast<const char*>(frame.value);
+                break;
+            case SampleFrame::Kind::Type:
+                out += reinterpret_cast<const std::type_info*>(frame.value)
+                               ->name();
+                break;
+        }
+    }
+
+    std::map<std::string, uint64_t> counts_;
+    uint64_t total_ = 0;
+};
+
+} // namespace corral
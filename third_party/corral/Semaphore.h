@@ -44,8 +44,25 @@ class Semaphore : public detail::ParkingLotImpl<Semaphore> {
 
     size_t value() const noexcept { return value_; }
 
+    /// Decrements the semaphore and returns true if a permit is
+    /// immediately available; returns false (without waiting) if the
+    /// counter is zero. A plain counter operation — no awaitable is
+    /// constructed and the caller need not be a coroutine. Cannot barge
+    /// ahead of tasks parked in acquire(): release() hands permits to
+    /// parked waiters directly, so value_ is only nonzero when nobody
+    /// is waiting.
+    bool tryAcquire() noexcept {
+        if (value_ == 0) {
+            return false;
+        }
+        --value_;
+        return true;
+    }
+
     /// An awaitable that decrements the semaphore, suspending
-    /// the caller if it is currently zero.
+    /// the caller if it is currently zero. When a permit is available,
+    /// await_ready() short-circuits the whole suspend path: the caller
+    /// continues inline without reaching the executor.
     [[nodiscard]] corral::Awaitable<void> auto acquire();
 
     /// Increments the semaphore, waking one suspended task (if any).
@@ -92,14 +109,29 @@ class Semaphore::Awaitable : public detail::ParkingLotImpl<Semaphore>::Parked {
     using Parked::Parked;
     bool await_ready() const noexcept { return this->object().value() > 0; }
 
-    void await_suspend(Handle h) { this->doSuspend(h); }
+    void await_suspend(Handle h) {
+        parked_ = true;
+        this->doSuspend(h);
+    }
 
     auto await_resume() {
-        --this->object().value_;
+        // Only the fast path (never suspended) takes its permit from the
+        // counter; await_ready() and this decrement run back to back, so
+        // nothing can interleave. A parked waiter instead receives its
+        // permit directly from release(), which never increments value_
+        // when a waiter exists — decrementing here too would underflow
+        // the counter if a tryAcquire() ran between the unpark and the
+        // waiter resuming.
+        if (!parked_) {
+            --this->object().value_;
+        }
         if constexpr (!std::is_same_v<Retval, void>) {
             return Retval(this->object());
         }
     }
+
+  private:
+    bool parked_ = false;
 };
 
 inline corral::Awaitable<void> auto Semaphore::acquire() {
@@ -111,8 +143,16 @@ inline corral::Awaitable<Semaphore::Lock> auto Semaphore::lock() {
 }
 
 inline void Semaphore::release() {
-    ++value_;
-    unparkOne();
+    if (!empty()) {
+        // Hand the permit straight to the oldest waiter instead of
+        // publishing it in value_. Unparks resume through the executor,
+        // so an incremented counter would be visible to tryAcquire()
+        // (and fresh acquire()s) before the waiter runs — and the permit
+        // could be taken out from under it.
+        unparkOne();
+    } else {
+        ++value_;
+    }
 }
 
 } // namespace corral
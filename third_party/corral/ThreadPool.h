@@ -0,0 +1,289 @@
+// This file is part of corral, a lightweight C++20 coroutine library.
+//
+// Copyright (c) 2024 Hudson River Trading LLC <opensource@hudson-trading.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "concepts.h"
+#include "config.h"
+#include "defs.h"
+
+namespace corral {
+
+/// A multi-threaded work-stealing pool for offloading CPU-bound function
+/// work. Each worker owns a run queue; an idle worker steals from the back
+/// of its peers' queues before parking, so a burst of independent jobs
+/// spreads across cores without a single contended global queue.
+///
+/// The awaiting coroutine itself never migrates: `run(fn)` executes `fn()`
+/// on a worker while the coroutine stays suspended, and the coroutine is
+/// resumed back on its own executor thread once the result is delivered.
+/// (Moving the coroutine to a worker would let it `co_return` there,
+/// mutating nursery task lists and submitting to the executor — neither of
+/// which is thread-safe.)
+///
+///     corral::ThreadPool pool(16);
+///     CORRAL_WITH_NURSERY(n) {
+///         for (auto& item : work) {
+///             n.start([&]() -> corral::Task<> {
+///                 co_await pool.run([&] { crunch(item); }); // off-thread
+///                 publish(item); // back on the executor thread, as always
+///             });
+///         }
+///         co_return corral::join;
+///     };
+///
+/// Finished jobs park in a completion queue; the thread driving the
+/// executor must call drainCompletions() when it wakes — the same duty it
+/// already has toward Executor::runDueTimers() — to resume the waiting
+/// coroutines. run() is not an interruption point: once posted, the job
+/// runs to completion, and a cancelled awaiter observes cancellation when
+/// its completion is drained.
+class ThreadPool {
+    struct Job;
+    template <class Fn> class RunAwaitable;
+
+  public:
+    explicit ThreadPool(
+            unsigned numThreads = std::thread::hardware_concurrency()) {
+        workers_ = std::vector<Worker>(numThreads ? numThreads : 1);
+        for (unsigned i = 0; i < workers_.size(); ++i) {
+            threads_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        stopping_.store(true, std::memory_order_relaxed);
+        for (Worker& w : workers_) {
+            // Taking the lock (even empty) pairs with the check a parking
+            // worker does under it, so the notify cannot be missed.
+            { std::lock_guard lk(w.mutex); }
+            w.cv.notify_all();
+        }
+        for (auto& t : threads_) {
+            t.join();
+        }
+        // A pending completion here is a coroutine that will never be
+        // resumed: drainCompletions() was not called before teardown.
+        CORRAL_ASSERT(completions_ == nullptr);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Runs `fn()` on a pool worker; the co_await evaluates to its result
+    /// (exceptions propagate). The awaiting coroutine remains parked on
+    /// its executor thread throughout and resumes there.
+    template <std::invocable<> Fn> corral::Awaitable auto run(Fn fn) {
+        return RunAwaitable<Fn>(*this, std::move(fn));
+    }
+
+    /// Resumes every coroutine whose pool work has finished. Must be
+    /// called from the thread driving the executor the awaiters live on;
+    /// returns the number of coroutines resumed.
+    size_t drainCompletions() {
+        Job* job;
+        {
+            std::lock_guard lk(completionsMutex_);
+            job = std::exchange(completions_, nullptr);
+            completionsTail_ = nullptr;
+        }
+        size_t resumed = 0;
+        while (job != nullptr) {
+            // The resume may destroy the awaitable (it lives in the
+            // resumed coroutine's frame), so step off the node first.
+            Job* next = job->next;
+            job->handle.resume();
+            ++resumed;
+            job = next;
+        }
+        return resumed;
+    }
+
+    /// True if drainCompletions() has work to do; lets a polling event
+    /// loop avoid the resume path when idle.
+    bool hasCompletions() const noexcept {
+        std::lock_guard lk(completionsMutex_);
+        return completions_ != nullptr;
+    }
+
+    unsigned size() const noexcept {
+        return static_cast<unsigned>(workers_.size());
+    }
+
+  private:
+    /// Type-erased unit of work; embedded in the RunAwaitable (and thus
+    /// the awaiting coroutine's frame), so posting allocates nothing.
+    struct Job {
+        void (*execute)(Job*) noexcept;
+        std::coroutine_handle<> handle;
+        Job* next = nullptr;
+    };
+
+    // Each worker's queue has its own lock, so posting to one worker, a
+    // peer stealing from another, and a third popping its own queue all
+    // proceed in parallel; the alignment keeps neighbouring workers' locks
+    // off each other's cache lines.
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Job*> queue; // Guarded by this worker's mutex
+    };
+
+    void post(Job* job) {
+        Worker& w = workers_[nextWorker_.fetch_add(1, std::memory_order_relaxed) %
+                             workers_.size()];
+        {
+            std::lock_guard lk(w.mutex);
+            w.queue.push_back(job);
+        }
+        w.cv.notify_one();
+    }
+
+    Job* take(unsigned self) {
+        // Own queue first (LIFO end for cache warmth)...
+        {
+            Worker& own = workers_[self];
+            std::lock_guard lk(own.mutex);
+            if (!own.queue.empty()) {
+                Job* job = own.queue.back();
+                own.queue.pop_back();
+                return job;
+            }
+        }
+        // ...then steal the oldest entry from a peer, locking only the
+        // victim being probed.
+        for (unsigned i = 1; i < workers_.size(); ++i) {
+            Worker& victim = workers_[(self + i) % workers_.size()];
+            std::lock_guard lk(victim.mutex);
+            if (!victim.queue.empty()) {
+                Job* job = victim.queue.front();
+                victim.queue.pop_front();
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Parks a finished job for the executor side to pick up; never
+    /// resumes anything on the worker thread.
+    void complete(Job* job) {
+        std::lock_guard lk(completionsMutex_);
+        job->next = nullptr;
+        if (completionsTail_ != nullptr) {
+            completionsTail_->next = job;
+        } else {
+            completions_ = job;
+        }
+        completionsTail_ = job;
+    }
+
+    void workerLoop(unsigned self) {
+        Worker& own = workers_[self];
+        while (true) {
+            if (Job* job = take(self)) {
+                job->execute(job);
+                complete(job);
+                continue;
+            }
+            std::unique_lock lk(own.mutex);
+            if (stopping_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if (!own.queue.empty()) {
+                continue; // Posted between the failed take() and the lock
+            }
+            // Work posted to a peer after our steal pass wakes that peer,
+            // not us, so parking here cannot strand a runnable job.
+            own.cv.wait(lk);
+        }
+    }
+
+    template <class Fn> class RunAwaitable : private Job {
+        using Result = std::invoke_result_t<Fn&>;
+        struct NoResult {};
+
+      public:
+        RunAwaitable(ThreadPool& pool, Fn fn)
+          : Job{&RunAwaitable::executeThunk}, pool_(pool), fn_(std::move(fn)) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            pool_.post(this);
+        }
+
+        Result await_resume() {
+            if (exception_) {
+                std::rethrow_exception(exception_);
+            }
+            if constexpr (!std::is_void_v<Result>) {
+                return std::move(*result_);
+            }
+        }
+
+      private:
+        static void executeThunk(Job* job) noexcept {
+            auto* self = static_cast<RunAwaitable*>(job);
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    self->fn_();
+                } else {
+                    self->result_.emplace(self->fn_());
+                }
+            } catch (...) { self->exception_ = std::current_exception(); }
+        }
+
+        ThreadPool& pool_;
+        Fn fn_;
+        [[no_unique_address]] std::conditional_t<std::is_void_v<Result>,
+                                                 NoResult,
+                                                 std::optional<Result>>
+                result_;
+        std::exception_ptr exception_;
+    };
+
+    std::vector<Worker> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<unsigned> nextWorker_{0};
+    std::atomic<bool> stopping_{false};
+
+    Job* completions_ = nullptr; // Singly linked FIFO of finished jobs
+    Job* completionsTail_ = nullptr;
+    mutable std::mutex completionsMutex_;
+};
+
+} // namespace corral
@@ -0,0 +1,115 @@
+// This file is part of corral, a lightweight C++20 coroutine library.
+//
+// Copyright (c) 2024 Hudson River Trading LLC <opensource@hudson-trading.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <chrono>
+
+#include "Executor.h"
+#include "detail/TimerWheel.h"
+
+namespace corral {
+
+namespace detail {
+
+/// Awaitable behind sleepFor()/sleepUntil(): one TimerWheelEntry embedded
+/// in the coroutine's frame, armed on the current executor's wheel at
+/// suspend time. No allocation, no thread, no per-timer event-loop object.
+class SleepAwaitable : private TimerWheelEntry {
+  public:
+    explicit SleepAwaitable(Clock::time_point deadline)
+      : TimerWheelEntry(&SleepAwaitable::onFire), when_(deadline) {}
+
+    void await_set_executor(Executor* executor) noexcept {
+        executor_ = executor;
+    }
+
+    bool await_ready() const noexcept { return when_ <= Clock::now(); }
+
+    void await_suspend(Handle h) {
+        CORRAL_TRACE("    ...sleep %p until deadline", this);
+        handle_ = h;
+        executor_->timers().schedule(*this, when_);
+    }
+
+    void await_resume() {}
+
+    /// Early-cancel: a timer still parked on the wheel can be dropped
+    /// synchronously by unlinking its entry. If it has already fired,
+    /// onFire() has queued a resume callback holding `this` on the
+    /// executor; completing the cancellation now would let the task
+    /// destroy the coroutine frame (which embeds this awaitable) under
+    /// that callback, so report the cancel as merely pending and let the
+    /// queued resume deliver it.
+    bool await_cancel(Handle) noexcept {
+        if (!armed()) {
+            return false;
+        }
+        executor_->timers().cancel(*this);
+        handle_ = std::noop_coroutine();
+        return true;
+    }
+
+    /// If the cancel came too late and the sleep completed anyway, the
+    /// wakeup carries no value worth keeping: resume as cancelled.
+    auto await_must_resume() const noexcept { return std::false_type{}; }
+
+  private:
+    static void onFire(TimerWheelEntry* entry) noexcept {
+        auto* self = static_cast<SleepAwaitable*>(entry);
+        // Defer the resume through the executor so the wakeup obeys the
+        // no-nested-callbacks rule like any other unpark.
+        self->executor_->schedule(
+                +[](SleepAwaitable* s) noexcept {
+                    std::exchange(s->handle_, std::noop_coroutine()).resume();
+                },
+                self);
+    }
+
+    Clock::time_point when_;
+    Executor* executor_ = nullptr;
+    Handle handle_;
+};
+
+} // namespace detail
+
+/// Suspends the caller until `deadline`, using the timer wheel owned by
+/// the current executor. Unlike the event-loop sleepFor() overloads
+/// (asio.h, uring.h), this needs no event-loop timer object per sleep:
+/// each pending timeout is two pointer writes on the wheel, so a hundred
+/// thousand concurrent timeouts are fine. The driving event loop must
+/// call Executor::runDueTimers() when it wakes and may use
+/// Executor::nextTimerDeadline() to bound its block.
+inline corral::Awaitable<void> auto sleepUntil(
+        std::chrono::steady_clock::time_point deadline) {
+    return detail::SleepAwaitable(deadline);
+}
+
+/// Suspends the caller for (at least) `delay`. See sleepUntil().
+inline corral::Awaitable<void> auto sleepFor(
+        std::chrono::steady_clock::duration delay) {
+    return sleepUntil(std::chrono::steady_clock::now() + delay);
+}
+
+} // namespace corral
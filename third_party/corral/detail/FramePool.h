@@ -0,0 +1,118 @@
+// This file is part of corral, a lightweight C++20 coroutine library.
+//
+// Copyright (c) 2024 Hudson River Trading LLC <opensource@hudson-trading.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <stddef.h>
+
+#include <new>
+
+#include "../config.h"
+
+namespace corral::detail {
+
+/// Size-classed recycler for coroutine frames.
+///
+/// Every task spawn allocates its frame from the heap, and a workload
+/// spawning many short-lived coroutines spends a noticeable share of its
+/// time in malloc. Frames cluster into a handful of sizes (a coroutine's
+/// frame size is a compile-time property of its body), so recycling them
+/// through per-thread, per-size-class freelists turns the steady state into
+/// a pointer pop / pointer push with no malloc traffic at all.
+///
+/// Sizes are rounded up to 64-byte classes; a freed frame of class N serves
+/// any later request of class N. The compiler emits sized deallocation for
+/// coroutine frames, so no per-allocation header is needed. Frames larger
+/// than the biggest class (rare: a huge coroutine body) fall through to
+/// plain operator new/delete. Freelists are thread-local — matching the
+/// rest of corral's single-threaded-executor model — so no synchronization
+/// appears anywhere on the path.
+class FramePool {
+    static constexpr size_t kClassShift = 6; // 64-byte granularity
+    static constexpr size_t kClassSize = size_t(1) << kClassShift;
+    static constexpr size_t kNumClasses = 16; // Pool frames up to 1 KiB
+    static constexpr size_t kMaxFreePerClass = 256; // Cap cached memory
+
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+
+    struct ThreadCache {
+        FreeFrame* head[kNumClasses] = {};
+        size_t count[kNumClasses] = {};
+
+        ~ThreadCache() {
+            for (size_t c = 0; c < kNumClasses; ++c) {
+                while (FreeFrame* frame = head[c]) {
+                    head[c] = frame->next;
+                    ::operator delete(frame);
+                }
+            }
+        }
+    };
+
+    static ThreadCache& cache() {
+        static CORRAL_THREAD_LOCAL ThreadCache tc;
+        return tc;
+    }
+
+    static size_t classOf(size_t size) {
+        return (size + kClassSize - 1) >> kClassShift;
+    }
+
+  public:
+    static void* allocate(size_t size) {
+        const size_t cls = classOf(size);
+        if (cls >= kNumClasses) {
+            return ::operator new(size);
+        }
+        ThreadCache& tc = cache();
+        if (FreeFrame* frame = tc.head[cls]) {
+            tc.head[cls] = frame->next;
+            --tc.count[cls];
+            return frame;
+        }
+        // Growth path: carve a full-class block so the frame can be reused
+        // by any request of this class, whatever its exact size.
+        return ::operator new(cls << kClassShift);
+    }
+
+    static void deallocate(void* ptr, size_t size) noexcept {
+        const size_t cls = classOf(size);
+        if (cls >= kNumClasses) {
+            ::operator delete(ptr);
+            return;
+        }
+        ThreadCache& tc = cache();
+        if (tc.count[cls] >= kMaxFreePerClass) {
+            ::operator delete(ptr);
+            return;
+        }
+        FreeFrame* frame = static_cast<FreeFrame*>(ptr);
+        frame->next = tc.head[cls];
+        tc.head[cls] = frame;
+        ++tc.count[cls];
+    }
+};
+
+} // namespace corral::detail
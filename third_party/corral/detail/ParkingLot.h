@@ -26,8 +26,29 @@
 #include "IntrusiveList.h"
 #include "utility.h"
 
+#ifdef CORRAL_STATS
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
 namespace corral::detail {
 
+#ifdef CORRAL_STATS
+/// Timestamp source for park/unpark latency accounting: raw cycles where
+/// the TSC is available, nanoseconds otherwise.
+inline uint64_t statsCycleCount() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+#endif
+
 /// A common part of ParkingLot, Event and Semaphore,
 /// an intrusive wait queue.
 template <class Self> class ParkingLotImpl {
@@ -36,6 +57,22 @@ template <class Self> class ParkingLotImpl {
     ParkingLotImpl(ParkingLotImpl&&) = delete;
     ParkingLotImpl& operator=(ParkingLotImpl&&) = delete;
 
+#ifdef CORRAL_STATS
+    /// Per-lot counters, only present (and only updated) under
+    /// CORRAL_STATS; without it the suspend path is exactly as before.
+    struct Stats {
+        uint64_t parks = 0;        ///< doSuspend() calls
+        uint64_t wakes = 0;        ///< unpark() calls (unparkOne/unparkAll)
+        uint64_t cancellations = 0; ///< tasks cancelled while parked
+        uint64_t currentlyParked = 0; ///< gauge: tasks parked right now
+        uint64_t maxParked = 0;       ///< high-water mark of the gauge
+        /// Total cycles tasks spent between suspend and resume; divide by
+        /// `wakes` for the mean wake-to-resume latency.
+        uint64_t parkedCycles = 0;
+    };
+    const Stats& stats() const noexcept { return stats_; }
+#endif
+
   protected:
     class Parked : public IntrusiveListItem<Parked> {
       public:
@@ -44,6 +81,7 @@ template <class Self> class ParkingLotImpl {
         auto await_cancel(Handle) noexcept {
             this->unlink();
             handle_ = std::noop_coroutine();
+            object_.noteCancelled();
             return std::true_type{};
         }
 
@@ -53,16 +91,28 @@ template <class Self> class ParkingLotImpl {
 
         void doSuspend(Handle h) {
             handle_ = h;
+#ifdef CORRAL_STATS
+            parkedAt_ = statsCycleCount();
+#endif
+            object_.noteParked();
             object_.parked_.push_back(*this);
         }
         void unpark() {
             this->unlink();
+#ifdef CORRAL_STATS
+            object_.noteUnparked(parkedAt_);
+#else
+            object_.noteUnparked(0);
+#endif
             std::exchange(handle_, std::noop_coroutine()).resume();
         }
 
       private:
         Self& object_;
         Handle handle_;
+#ifdef CORRAL_STATS
+        uint64_t parkedAt_ = 0;
+#endif
         friend class ParkingLotImpl<Self>;
     };
     friend class Parked;
@@ -99,7 +149,34 @@ template <class Self> class ParkingLotImpl {
     bool empty() const { return parked_.empty(); }
 
   private:
+    // Stats hooks. The no-stats versions are empty inline functions, so the
+    // suspend/resume paths compile down to exactly what they were before.
+#ifdef CORRAL_STATS
+    void noteParked() noexcept {
+        ++stats_.parks;
+        if (++stats_.currentlyParked > stats_.maxParked) {
+            stats_.maxParked = stats_.currentlyParked;
+        }
+    }
+    void noteUnparked(uint64_t parkedAt) noexcept {
+        ++stats_.wakes;
+        --stats_.currentlyParked;
+        stats_.parkedCycles += statsCycleCount() - parkedAt;
+    }
+    void noteCancelled() noexcept {
+        ++stats_.cancellations;
+        --stats_.currentlyParked;
+    }
+#else
+    void noteParked() noexcept {}
+    void noteUnparked(uint64_t) noexcept {}
+    void noteCancelled() noexcept {}
+#endif
+
     IntrusiveList<Parked> parked_;
+#ifdef CORRAL_STATS
+    Stats stats_;
+#endif
 };
 
 } // namespace corral::detail
@@ -30,6 +30,7 @@
 #include "../defs.h"
 #include "../utility.h"
 #include "ABI.h"
+#include "FramePool.h"
 #include "IntrusiveList.h"
 #include "ScopeGuard.h"
 #include "frames.h"
@@ -154,8 +155,23 @@ class BasePromise : private TaskFrame, public IntrusiveListItem<BasePromise> {
     BasePromise(BasePromise&&) = delete;
     BasePromise& operator=(BasePromise&&) = delete;
 
+    /// Coroutine frames for tasks are drawn from the size-classed frame
+    /// pool instead of the heap; see detail/FramePool.h. The compiler
+    /// routes frame allocation through the promise type, so declaring
+    /// these here covers every task coroutine.
+    static void* operator new(size_t size) { return FramePool::allocate(size); }
+    static void operator delete(void* ptr, size_t size) noexcept {
+        FramePool::deallocate(ptr, size);
+    }
+
     void setExecutor(Executor* ex) { executor_ = ex; }
 
+    /// The priority lane this task's resumptions are scheduled into.
+    /// Set by the nursery when the task is spawned (tasks inherit their
+    /// nursery's priority); defaults to Normal.
+    void setPriority(Priority priority) { priority_ = priority; }
+    Priority priority() const noexcept { return priority_; }
+
     /// Requests the cancellation of the running task.
     ///
     /// If its current awaitee (if any) supports cancellation,
@@ -330,6 +346,8 @@ class BasePromise : private TaskFrame, public IntrusiveListItem<BasePromise> {
         // Prevent further doResume()s from scheduling the task again
         onResume<&BasePromise::doNothing>();
 
+        // The resume goes into the task's own lane, so a latency-critical
+        // task never queues behind batch resumptions submitted earlier.
         executor_->runSoon(
                 +[](void* arg) noexcept {
                     auto h = CoroutineHandle<BasePromise>::from_address(arg);
@@ -339,7 +357,7 @@ class BasePromise : private TaskFrame, public IntrusiveListItem<BasePromise> {
                     auto guard = self.executor_->markActive(self.proxyHandle());
                     h.resume();
                 },
-                realHandle().address());
+                realHandle().address(), priority_);
     }
 
     /// Called when this task's awaitee completes after its cancellation was
@@ -421,6 +439,7 @@ class BasePromise : private TaskFrame, public IntrusiveListItem<BasePromise> {
   private /*fields*/:
     Executor* executor_ = nullptr;
     BaseTaskParent* parent_ = nullptr;
+    Priority priority_ = Priority::Normal;
 
     // These enums live in a union with Awaitee, so their values must
     // be distinguishable from the possible object representations of an
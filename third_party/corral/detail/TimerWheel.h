@@ -0,0 +1,152 @@
+// This file is part of corral, a lightweight C++20 coroutine library.
+//
+// Copyright (c) 2024 Hudson River Trading LLC <opensource@hudson-trading.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "IntrusiveList.h"
+
+namespace corral::detail {
+
+class TimerWheel;
+
+/// One armed timer. Embedded in the awaitable that owns it (see Timer.h),
+/// so arming a timeout allocates nothing.
+class TimerWheelEntry : public IntrusiveListItem<TimerWheelEntry> {
+    friend class TimerWheel;
+
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerWheelEntry(void (*fire)(TimerWheelEntry*) noexcept)
+      : fire_(fire) {}
+
+    Clock::time_point deadline() const noexcept { return deadline_; }
+    bool armed() const noexcept { return armed_; }
+
+  private:
+    void (*fire_)(TimerWheelEntry*) noexcept;
+    Clock::time_point deadline_{};
+    bool armed_ = false;
+};
+
+/// A hashed timer wheel: entries hash into one of kSlots intrusive lists
+/// by their deadline tick, so arming and cancelling a timer are O(1)
+/// pointer operations regardless of how many timers are pending — which
+/// is what makes hundreds of thousands of concurrent timeouts viable.
+/// Due entries are found by advancing the tick cursor and scanning only
+/// the slots it passes.
+class TimerWheel {
+  public:
+    using Clock = TimerWheelEntry::Clock;
+
+    static constexpr size_t Slots = 256; // Power of two
+    static constexpr Clock::duration Tick = std::chrono::milliseconds(1);
+
+    TimerWheel() : cursor_(tickOf(Clock::now())) {}
+
+    size_t size() const noexcept { return armed_; }
+    bool empty() const noexcept { return armed_ == 0; }
+
+    /// Arm `entry` to fire at `deadline` (immediately on the next runDue()
+    /// if the deadline has already passed).
+    void schedule(TimerWheelEntry& entry, Clock::time_point deadline) {
+        entry.deadline_ = deadline;
+        entry.armed_ = true;
+        uint64_t tick = tickOf(deadline);
+        if (tick < cursor_) {
+            tick = cursor_;
+        }
+        slots_[tick & (Slots - 1)].push_back(entry);
+        ++armed_;
+    }
+
+    /// Disarm `entry`; a no-op if it is not armed. O(1).
+    void cancel(TimerWheelEntry& entry) {
+        if (entry.armed_) {
+            slots_[0].erase(entry); // erase() only unlinks; the list
+                                    // identity does not matter
+            entry.armed_ = false;
+            --armed_;
+        }
+    }
+
+    /// Fire every entry due at `now` or earlier, in wheel order. The fire
+    /// callback must not re-enter the wheel for the firing entry (it may
+    /// arm other entries). Returns the number fired.
+    size_t runDue(Clock::time_point now) {
+        size_t fired = 0;
+        const uint64_t target = tickOf(now);
+        while (cursor_ <= target) {
+            IntrusiveList<TimerWheelEntry>& slot = slots_[cursor_ & (Slots - 1)];
+            for (auto it = slot.begin(); it != slot.end();) {
+                TimerWheelEntry& entry = *it;
+                ++it; // Advance before unlinking invalidates the iterator
+                if (entry.deadline_ <= now) {
+                    slot.erase(entry);
+                    entry.armed_ = false;
+                    --armed_;
+                    entry.fire_(&entry);
+                    ++fired;
+                }
+                // Entries with later deadlines share the slot (later laps
+                // or later sub-tick times); they stay put.
+            }
+            if (cursor_ == target) {
+                break;
+            }
+            ++cursor_;
+        }
+        return fired;
+    }
+
+    /// Earliest pending deadline, or Clock::time_point::max() if no timer
+    /// is armed. O(number of armed timers); meant for an event loop
+    /// deciding how long it may block, not for hot paths.
+    Clock::time_point nextDeadline() const {
+        Clock::time_point earliest = Clock::time_point::max();
+        for (const IntrusiveList<TimerWheelEntry>& slot : slots_) {
+            for (const TimerWheelEntry& entry : slot) {
+                if (entry.deadline_ < earliest) {
+                    earliest = entry.deadline_;
+                }
+            }
+        }
+        return earliest;
+    }
+
+  private:
+    static uint64_t tickOf(Clock::time_point tp) noexcept {
+        return static_cast<uint64_t>(tp.time_since_epoch() / Tick);
+    }
+
+    IntrusiveList<TimerWheelEntry> slots_[Slots];
+    uint64_t cursor_;
+    size_t armed_ = 0;
+};
+
+} // namespace corral::detail